@@ -79,6 +79,7 @@ AC_CHECK_FUNCS([posix_memalign])
 AC_CHECK_FUNCS([mremap])
 AC_CHECK_FUNCS([sched_setaffinity sched_getaffinity])
 AC_CHECK_FUNCS([cpuset_setaffinity cpuset_getaffinity])
+AC_CHECK_FUNCS([process_vm_readv])
 
 
 #
@@ -95,6 +96,28 @@ AC_CHECK_DECLS([ethtool_cmd_speed, SPEED_UNKNOWN], [], [],
                [#include <linux/ethtool.h>])
 
 
+#
+# Socket zero-copy send (MSG_ZEROCOPY) definitions
+#
+AC_CHECK_DECLS([SO_ZEROCOPY, MSG_ZEROCOPY, SO_EE_ORIGIN_ZEROCOPY], [], [],
+               [#include <sys/socket.h>
+#include <linux/errqueue.h>])
+
+
+#
+# Socket busy polling and receive steering definitions
+#
+AC_CHECK_DECLS([SO_BUSY_POLL, SO_PREFER_BUSY_POLL, SO_INCOMING_CPU,
+                SO_INCOMING_NAPI_ID], [], [], [#include <sys/socket.h>])
+
+
+#
+# Anonymous shareable memory files
+#
+AC_CHECK_DECLS([memfd_create], [], [], [#define _GNU_SOURCE 1
+#include <sys/mman.h>])
+
+
 #
 # PowerPC query for TB frequency
 #
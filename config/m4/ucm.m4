@@ -98,6 +98,20 @@ AS_IF([test "x$bistro_hooks_happy" = "xyes"],
 
 AC_CHECK_FUNCS([__curbrk], [], [], [])
 
+#
+# userfaultfd memory events
+#
+uffd_events_happy=no
+AC_CHECK_DECLS([SYS_userfaultfd],
+               [AC_CHECK_HEADERS([linux/userfaultfd.h],
+                                 [uffd_events_happy=yes])],
+               [],
+               [#include <sys/syscall.h>])
+
+AS_IF([test "x$uffd_events_happy" = "xyes"],
+      [AC_DEFINE([UCM_UFFD_EVENTS], [1], [Enable userfaultfd memory events])],
+      [AC_DEFINE([UCM_UFFD_EVENTS], [0], [Enable userfaultfd memory events])])
+
 #
 # tcmalloc library - for testing only
 #
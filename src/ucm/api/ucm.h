@@ -65,6 +65,9 @@ typedef enum ucm_mmap_hook_mode {
     UCM_MMAP_HOOK_NONE,
     UCM_MMAP_HOOK_RELOC,
     UCM_MMAP_HOOK_BISTRO,
+    UCM_MMAP_HOOK_UFFD,   /* No hooks: @ref UCM_EVENT_VM_UNMAPPED is reported
+                             asynchronously by userfaultfd, only for the memory
+                             ranges passed to @ref ucm_vm_watch */
     UCM_MMAP_HOOK_LAST
 } ucm_mmap_hook_mode_t;
 
@@ -309,6 +312,28 @@ void ucm_set_external_event(int events);
 void ucm_unset_external_event(int events);
 
 
+/**
+ * @brief Watch a memory range for unmap events.
+ *
+ * When memory events are reported by userfaultfd (see @ref UCM_MMAP_HOOK_UFFD),
+ * @ref UCM_EVENT_VM_UNMAPPED is reported only for the memory ranges which are
+ * watched, so other memory operations in the process are not affected. The
+ * event is reported asynchronously, from a helper thread, after the memory was
+ * unmapped or its pages were released. The range is not watched anymore after
+ * it's reported as unmapped.
+ *
+ * @param [in]  address    Start of the memory range to watch.
+ * @param [in]  length     Length of the memory range to watch.
+ *
+ * @return UCS_OK if the range is watched, UCS_ERR_UNSUPPORTED if unmap events
+ *         are not reported by userfaultfd, so there is no need to watch the
+ *         range, or another error if the range cannot be watched (for example,
+ *         a file-backed mapping), in which case no unmap events will be
+ *         reported for it.
+ */
+ucs_status_t ucm_vm_watch(void *address, size_t length);
+
+
 /**
  * @brief Test event handlers
  *
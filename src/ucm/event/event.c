@@ -496,15 +496,21 @@ static ucs_status_t ucm_event_install(int events)
 
     ucm_debug("mmap hooks are ready");
 
-    malloc_events = events & ~(UCM_EVENT_MEM_TYPE_ALLOC |
-                               UCM_EVENT_MEM_TYPE_FREE);
-    status = ucm_malloc_install(malloc_events);
-    if (status != UCS_OK) {
-        ucm_debug("failed to install malloc events");
-        goto out_unlock;
-    }
+    if (ucm_mmap_hook_mode() == UCM_MMAP_HOOK_UFFD) {
+        /* Heap memory returned to the OS by munmap/madvise/brk is reported
+         * by userfaultfd like any other watched range */
+        ucm_debug("uffd mode: not installing malloc hooks");
+    } else {
+        malloc_events = events & ~(UCM_EVENT_MEM_TYPE_ALLOC |
+                                   UCM_EVENT_MEM_TYPE_FREE);
+        status = ucm_malloc_install(malloc_events);
+        if (status != UCS_OK) {
+            ucm_debug("failed to install malloc events");
+            goto out_unlock;
+        }
 
-    ucm_debug("malloc hooks are ready");
+        ucm_debug("malloc hooks are ready");
+    }
 
     /* Call extra event installers */
     UCS_MODULE_FRAMEWORK_LOAD(ucm, UCS_MODULE_LOAD_FLAG_NODELETE);
@@ -370,6 +370,19 @@ ucs_status_t ucm_mmap_install(int events)
 
     pthread_mutex_lock(&ucm_mmap_install_mutex);
 
+    if (ucm_mmap_hook_mode() == UCM_MMAP_HOOK_UFFD) {
+        /* userfaultfd reports only the release of watched ranges, and does it
+         * asynchronously, so there is nothing to test here */
+        if (events & ~(UCM_EVENT_VM_UNMAPPED | UCM_EVENT_MEM_TYPE_ALLOC |
+                       UCM_EVENT_MEM_TYPE_FREE)) {
+            ucm_debug("events 0x%x are not supported in uffd mode", events);
+            status = UCS_ERR_UNSUPPORTED;
+        } else {
+            status = ucm_uffd_install();
+        }
+        goto out_unlock;
+    }
+
     /* Replace aggregate events with the native events which make them */
     native_events = ucm_mmap_events_to_native_events(events);
     if (ucs_test_all_flags(ucm_mmap_installed_events, native_events)) {
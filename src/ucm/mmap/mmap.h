@@ -12,6 +12,7 @@
 
 #define UCM_MMAP_HOOK_RELOC_STR  "reloc"
 #define UCM_MMAP_HOOK_BISTRO_STR "bistro"
+#define UCM_MMAP_HOOK_UFFD_STR   "uffd"
 
 #if UCM_BISTRO_HOOKS
 #  define UCM_DEFAULT_HOOK_MODE UCM_MMAP_HOOK_BISTRO
@@ -36,6 +37,7 @@ int ucm_override_madvise(void *addr, size_t length, int advice);
 void ucm_fire_mmap_events(int events);
 ucs_status_t ucm_mmap_test_installed_events(int events);
 ucs_status_t ucm_mmap_test_events(int events, const char *event_type);
+ucs_status_t ucm_uffd_install(void);
 
 static UCS_F_ALWAYS_INLINE ucm_mmap_hook_mode_t ucm_mmap_hook_mode(void)
 {
@@ -0,0 +1,339 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "mmap.h"
+
+#include <ucm/api/ucm.h>
+#include <ucm/event/event.h>
+#include <ucm/util/log.h>
+#include <ucm/util/sys.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/sys/math.h>
+
+#if UCM_UFFD_EVENTS
+#  include <linux/userfaultfd.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <pthread.h>
+#  include <signal.h>
+#  include <unistd.h>
+#  include <fcntl.h>
+#  include <string.h>
+#  include <errno.h>
+#endif
+
+
+#if UCM_UFFD_EVENTS
+
+/* Maximal number of messages to read from the uffd at once */
+#define UCM_UFFD_MAX_MSGS 16
+
+static pthread_mutex_t ucm_uffd_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int    ucm_uffd_fd   = -1;
+static uint64_t        ucm_uffd_reg_mode;
+
+
+static int ucm_uffd_open(void)
+{
+    return syscall(SYS_userfaultfd, O_CLOEXEC);
+}
+
+static void ucm_uffd_unregister(int fd, uint64_t start, uint64_t len)
+{
+    struct uffdio_range range;
+
+    range.start = start;
+    range.len   = len;
+    if ((ioctl(fd, UFFDIO_UNREGISTER, &range) < 0) && (errno != EINVAL) &&
+        (errno != ENOMEM)) {
+        ucm_debug("uffd: failed to unregister 0x%lx..0x%lx: %m",
+                  (unsigned long)start, (unsigned long)(start + len));
+    }
+}
+
+static void ucm_uffd_handle_msg(int fd, const struct uffd_msg *msg)
+{
+    size_t page_size = ucm_get_page_size();
+    struct uffdio_range range;
+    uint64_t start;
+
+    switch (msg->event) {
+    case UFFD_EVENT_UNMAP:
+        /* The kernel dropped the registration together with the mapping */
+        ucm_trace("uffd: unmap 0x%llx..0x%llx", msg->arg.remove.start,
+                  msg->arg.remove.end);
+        ucm_vm_munmap((void*)(uintptr_t)msg->arg.remove.start,
+                      msg->arg.remove.end - msg->arg.remove.start);
+        break;
+    case UFFD_EVENT_REMOVE:
+        /* madvise(DONTNEED/REMOVE): the range stays mapped but its pages are
+         * gone, report it once and stop watching it */
+        ucm_trace("uffd: remove 0x%llx..0x%llx", msg->arg.remove.start,
+                  msg->arg.remove.end);
+        ucm_vm_munmap((void*)(uintptr_t)msg->arg.remove.start,
+                      msg->arg.remove.end - msg->arg.remove.start);
+        ucm_uffd_unregister(fd, msg->arg.remove.start,
+                            msg->arg.remove.end - msg->arg.remove.start);
+        break;
+    case UFFD_EVENT_REMAP:
+        ucm_trace("uffd: remap 0x%llx -> 0x%llx len %llu", msg->arg.remap.from,
+                  msg->arg.remap.to, msg->arg.remap.len);
+        ucm_vm_munmap((void*)(uintptr_t)msg->arg.remap.from,
+                      msg->arg.remap.len);
+        /* The registration moved with the mapping, nobody asked to watch the
+         * new location */
+        ucm_uffd_unregister(fd, msg->arg.remap.to, msg->arg.remap.len);
+        break;
+    case UFFD_EVENT_PAGEFAULT:
+        /* A missing page was touched after the range was watched, or a write
+         * hit a write-protected page. Stop watching that page and let the
+         * faulting thread continue. */
+        start = msg->arg.pagefault.address & ~(uint64_t)(page_size - 1);
+        ucm_trace("uffd: pagefault at 0x%llx flags 0x%llx",
+                  msg->arg.pagefault.address, msg->arg.pagefault.flags);
+        ucm_uffd_unregister(fd, start, page_size);
+        range.start = start;
+        range.len   = page_size;
+        ioctl(fd, UFFDIO_WAKE, &range);
+        break;
+    default:
+        ucm_debug("uffd: ignoring event %d", msg->event);
+        break;
+    }
+}
+
+static void *ucm_uffd_monitor_thread(void *arg)
+{
+    int fd = (int)(uintptr_t)arg;
+    struct uffd_msg msgs[UCM_UFFD_MAX_MSGS];
+    ssize_t nread;
+    size_t i;
+
+    for (;;) {
+        nread = read(fd, msgs, sizeof(msgs));
+        if (nread < 0) {
+            if ((errno == EINTR) || (errno == EAGAIN)) {
+                continue;
+            }
+
+            ucm_debug("uffd: monitor thread exiting: %m");
+            break;
+        }
+
+        for (i = 0; i < (nread / sizeof(*msgs)); ++i) {
+            ucm_uffd_handle_msg(fd, &msgs[i]);
+        }
+    }
+
+    return NULL;
+}
+
+static void ucm_uffd_atfork_child(void)
+{
+    /* The monitor thread does not exist in the child, and the registrations
+     * made by the parent are not inherited. Drop the descriptor, it will be
+     * created again on the next ucm_vm_watch(). */
+    if (ucm_uffd_fd >= 0) {
+        close(ucm_uffd_fd);
+        ucm_uffd_fd = -1;
+    }
+}
+
+static ucs_status_t ucm_uffd_query_features(uint64_t *features_p)
+{
+    struct uffdio_api api;
+    int fd;
+
+    fd = ucm_uffd_open();
+    if (fd < 0) {
+        ucm_debug("uffd: userfaultfd() failed: %m");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    api.api      = UFFD_API;
+    api.features = 0;
+    if (ioctl(fd, UFFDIO_API, &api) < 0) {
+        ucm_debug("uffd: UFFDIO_API failed: %m");
+        close(fd);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    close(fd);
+    *features_p = api.features;
+    return UCS_OK;
+}
+
+ucs_status_t ucm_uffd_install(void)
+{
+    static int atfork_installed = 0;
+    const uint64_t required     = UFFD_FEATURE_EVENT_UNMAP |
+                                  UFFD_FEATURE_EVENT_REMOVE |
+                                  UFFD_FEATURE_EVENT_REMAP;
+    sigset_t sigmask, old_sigmask;
+    struct uffdio_api api;
+    uint64_t features, wanted;
+    pthread_attr_t attr;
+    pthread_t thread;
+    ucs_status_t status;
+    int fd, ret;
+
+    pthread_mutex_lock(&ucm_uffd_lock);
+
+    if (ucm_uffd_fd >= 0) {
+        status = UCS_OK;
+        goto out_unlock;
+    }
+
+    /* The features can be enabled only once per descriptor, so probe what the
+     * kernel supports on a separate one */
+    status = ucm_uffd_query_features(&features);
+    if (status != UCS_OK) {
+        goto out_unlock;
+    }
+
+    if (!ucs_test_all_flags(features, required)) {
+        ucm_debug("uffd: kernel features 0x%lx lack unmap events 0x%lx",
+                  (unsigned long)features, (unsigned long)required);
+        status = UCS_ERR_UNSUPPORTED;
+        goto out_unlock;
+    }
+
+    wanted            = required;
+    ucm_uffd_reg_mode = UFFDIO_REGISTER_MODE_MISSING;
+#if defined(UFFD_FEATURE_PAGEFAULT_FLAG_WP) && defined(UFFDIO_REGISTER_MODE_WP)
+    /* Write-protect mode lets us watch ranges which are already populated
+     * without taking a fault on every first touch */
+    if (features & UFFD_FEATURE_PAGEFAULT_FLAG_WP) {
+        wanted           |= UFFD_FEATURE_PAGEFAULT_FLAG_WP;
+#  ifdef UFFD_FEATURE_WP_HUGETLBFS_SHMEM
+        wanted           |= features & UFFD_FEATURE_WP_HUGETLBFS_SHMEM;
+#  endif
+        ucm_uffd_reg_mode = UFFDIO_REGISTER_MODE_WP;
+    }
+#endif
+
+    fd = ucm_uffd_open();
+    if (fd < 0) {
+        ucm_debug("uffd: userfaultfd() failed: %m");
+        status = UCS_ERR_UNSUPPORTED;
+        goto out_unlock;
+    }
+
+    api.api      = UFFD_API;
+    api.features = wanted;
+    if (ioctl(fd, UFFDIO_API, &api) < 0) {
+        ucm_debug("uffd: UFFDIO_API(features=0x%lx) failed: %m",
+                  (unsigned long)wanted);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close;
+    }
+
+    /* The monitor thread must not take signals meant for the application */
+    sigfillset(&sigmask);
+    pthread_sigmask(SIG_SETMASK, &sigmask, &old_sigmask);
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    ret = pthread_create(&thread, &attr, ucm_uffd_monitor_thread,
+                         (void*)(uintptr_t)fd);
+    pthread_attr_destroy(&attr);
+    pthread_sigmask(SIG_SETMASK, &old_sigmask, NULL);
+    if (ret != 0) {
+        ucm_debug("uffd: failed to create monitor thread: %s", strerror(ret));
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close;
+    }
+
+    if (!atfork_installed) {
+        pthread_atfork(NULL, NULL, ucm_uffd_atfork_child);
+        atfork_installed = 1;
+    }
+
+    ucm_uffd_fd = fd;
+    ucm_debug("uffd: installed fd %d features 0x%lx register mode %s", fd,
+              (unsigned long)wanted,
+              (ucm_uffd_reg_mode == UFFDIO_REGISTER_MODE_MISSING) ? "missing" :
+                                                                     "wp");
+    status = UCS_OK;
+    goto out_unlock;
+
+err_close:
+    close(fd);
+out_unlock:
+    pthread_mutex_unlock(&ucm_uffd_lock);
+    return status;
+}
+
+static int ucm_uffd_register(int fd, uint64_t start, uint64_t len,
+                             uint64_t mode)
+{
+    struct uffdio_register reg;
+
+    reg.range.start = start;
+    reg.range.len   = len;
+    reg.mode        = mode;
+    return ioctl(fd, UFFDIO_REGISTER, &reg);
+}
+
+ucs_status_t ucm_vm_watch(void *address, size_t length)
+{
+    size_t page_size = ucm_get_page_size();
+    uint64_t start, end;
+    ucs_status_t status;
+    int fd, ret;
+
+    if (ucm_mmap_hook_mode() != UCM_MMAP_HOOK_UFFD) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    fd = ucm_uffd_fd;
+    if (fd < 0) {
+        status = ucm_uffd_install();
+        if (status != UCS_OK) {
+            return status;
+        }
+        fd = ucm_uffd_fd;
+    }
+
+    start = (uintptr_t)address & ~(uint64_t)(page_size - 1);
+    end   = ((uintptr_t)address + length + page_size - 1) &
+            ~(uint64_t)(page_size - 1);
+
+    ret = ucm_uffd_register(fd, start, end - start, ucm_uffd_reg_mode);
+    if ((ret < 0) && (errno == EINVAL) &&
+        (ucm_uffd_reg_mode != UFFDIO_REGISTER_MODE_MISSING)) {
+        /* Write-protect is not supported for this kind of memory */
+        ret = ucm_uffd_register(fd, start, end - start,
+                                UFFDIO_REGISTER_MODE_MISSING);
+    }
+    if (ret < 0) {
+        ucm_debug("uffd: failed to watch 0x%lx..0x%lx: %m",
+                  (unsigned long)start, (unsigned long)end);
+        return (errno == EBUSY) ? UCS_ERR_BUSY : UCS_ERR_IO_ERROR;
+    }
+
+    ucm_trace("uffd: watching 0x%lx..0x%lx", (unsigned long)start,
+              (unsigned long)end);
+    return UCS_OK;
+}
+
+#else
+
+ucs_status_t ucm_uffd_install(void)
+{
+    ucm_debug("uffd: userfaultfd events are not supported by this build");
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t ucm_vm_watch(void *address, size_t length)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+#endif
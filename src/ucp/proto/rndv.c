@@ -411,12 +411,12 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rndv_progress_rma_get_zcopy, (self),
     ucp_request_t *rndv_req = ucs_container_of(self, ucp_request_t, send.uct);
     ucp_ep_h ep             = rndv_req->send.ep;
     ucp_ep_config_t *config = ucp_ep_config(ep);
-    const size_t max_iovcnt = 1;
     uct_iface_attr_t* attrs;
     ucs_status_t status;
     size_t offset, length, ucp_mtu, remaining, align, chunk;
-    uct_iov_t iov[max_iovcnt];
-    size_t iovcnt;
+    size_t iovcnt           = 0;
+    size_t max_iovcnt;
+    uct_iov_t *iov;
     ucp_rsc_index_t rsc_index;
     ucp_dt_state_t state;
     uct_rkey_t uct_rkey;
@@ -459,7 +459,18 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rndv_progress_rma_get_zcopy, (self),
     max_zcopy = config->rndv.max_get_zcopy;
 
     offset    = rndv_req->send.state.dt.offset;
-    remaining = (uintptr_t)rndv_req->send.buffer % align;
+
+    if (UCP_DT_IS_CONTIG(rndv_req->send.datatype)) {
+        max_iovcnt = 1;
+        remaining  = (uintptr_t)rndv_req->send.buffer % align;
+    } else {
+        /* scatter the fetched data to as many receive IOV elements as the
+         * transport supports in a single operation */
+        ucs_assert(UCP_DT_IS_IOV(rndv_req->send.datatype));
+        max_iovcnt = ucs_max(attrs->cap.get.max_iov, 1);
+        remaining  = 0;
+    }
+    iov = ucs_alloca(max_iovcnt * sizeof(*iov));
 
     if ((offset == 0) && (remaining > 0) && (rndv_req->send.length > ucp_mtu)) {
         length = ucp_mtu - remaining;
@@ -485,7 +496,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rndv_progress_rma_get_zcopy, (self),
      * registration is not supported. for now SHM may avoid registration,
      * but it will work on single lane */
     ucp_dt_iov_copy_uct(ep->worker->context, iov, &iovcnt, max_iovcnt, &state,
-                        rndv_req->send.buffer, ucp_dt_make_contig(1), length,
+                        rndv_req->send.buffer, rndv_req->send.datatype, length,
                         ucp_ep_md_index(ep, lane),
                         rndv_req->send.mdesc);
 
@@ -640,12 +651,11 @@ static ucs_status_t ucp_rndv_req_send_rma_get(ucp_request_t *rndv_req,
     rndv_req->send.uct.func                = ucp_rndv_progress_rma_get_zcopy;
     rndv_req->send.buffer                  = rreq->recv.buffer;
     rndv_req->send.mem_type                = rreq->recv.mem_type;
-    rndv_req->send.datatype                = ucp_dt_make_contig(1);
+    rndv_req->send.datatype                = rreq->recv.datatype;
     rndv_req->send.length                  = rndv_rts_hdr->size;
     rndv_req->send.rndv_get.remote_request = rndv_rts_hdr->sreq.reqptr;
     rndv_req->send.rndv_get.remote_address = rndv_rts_hdr->address;
     rndv_req->send.rndv_get.rreq           = rreq;
-    rndv_req->send.datatype                = rreq->recv.datatype;
 
     status = ucp_ep_rkey_unpack(ep, rndv_rts_hdr + 1,
                                 &rndv_req->send.rndv_get.rkey);
@@ -654,7 +664,9 @@ static ucs_status_t ucp_rndv_req_send_rma_get(ucp_request_t *rndv_req,
                   ucp_ep_peer_name(ep), ucs_status_string(status));
     }
 
-    ucp_request_send_state_init(rndv_req, ucp_dt_make_contig(1), 0);
+    ucp_request_send_state_init(rndv_req, rndv_req->send.datatype,
+                                UCP_DT_IS_IOV(rndv_req->send.datatype) ?
+                                rreq->recv.state.dt.iov.iovcnt : 0);
     ucp_request_send_state_reset(rndv_req, ucp_rndv_get_completion,
                                  UCP_REQUEST_SEND_PROTO_RNDV_GET);
 
@@ -1149,6 +1161,23 @@ UCS_PROFILE_FUNC_VOID(ucp_rndv_receive, (worker, rreq, rndv_rts_hdr),
         goto out;
     }
 
+    if (UCP_DT_IS_IOV(rreq->recv.datatype) &&
+        UCP_MEM_IS_HOST(rreq->recv.mem_type) &&
+        (rndv_rts_hdr->address != 0) &&
+        ucp_rndv_test_zcopy_scheme_support(rndv_rts_hdr->size,
+                                           ep_config->rndv.min_get_zcopy,
+                                           ep_config->rndv.max_get_zcopy,
+                                           ep_config->rndv.get_zcopy_split)) {
+        /* fetch the contiguous remote buffer directly into the receive IOV
+         * elements, instead of sending it in fragments by active messages */
+        status = ucp_rndv_req_send_rma_get(rndv_req, rreq, rndv_rts_hdr);
+        if (status == UCS_OK) {
+            goto out;
+        }
+
+        ucp_rkey_destroy(rndv_req->send.rndv_get.rkey);
+    }
+
     if (UCP_DT_IS_CONTIG(rreq->recv.datatype)) {
         if ((rndv_rts_hdr->address != 0) &&
             ucp_rndv_test_zcopy_scheme_support(rndv_rts_hdr->size,
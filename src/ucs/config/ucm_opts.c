@@ -23,6 +23,9 @@ static const char *ucm_mmap_hook_modes[] = {
     [UCM_MMAP_HOOK_RELOC]  = UCM_MMAP_HOOK_RELOC_STR,
 #if UCM_BISTRO_HOOKS
     [UCM_MMAP_HOOK_BISTRO] = UCM_MMAP_HOOK_BISTRO_STR,
+#endif
+#if UCM_UFFD_EVENTS
+    [UCM_MMAP_HOOK_UFFD]   = UCM_MMAP_HOOK_UFFD_STR,
 #endif
     [UCM_MMAP_HOOK_LAST]   = NULL
 };
@@ -46,6 +49,11 @@ static ucs_config_field_t ucm_global_config_table[] = {
    " reloc  - use ELF relocation table to set hooks.\n"
 #if UCM_BISTRO_HOOKS
    " bistro - use binary instrumentation to set hooks.\n"
+#endif
+#if UCM_UFFD_EVENTS
+   " uffd   - don't set hooks, get unmap events from userfaultfd, only for\n"
+   "          memory which is in registration caches. The events are reported\n"
+   "          asynchronously, and other memory events are not supported.\n"
 #endif
    ,ucs_offsetof(ucm_global_config_t, mmap_hook_mode), UCS_CONFIG_TYPE_ENUM(ucm_mmap_hook_modes)},
 
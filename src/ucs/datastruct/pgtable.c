@@ -479,6 +479,7 @@ ucs_pgt_region_t *ucs_pgtable_lookup(const ucs_pgtable_t *pgtable,
 {
     const ucs_pgt_entry_t *pte;
     ucs_pgt_region_t *region;
+    ucs_pgt_entry_t entry;
     ucs_pgt_dir_t *dir;
     unsigned shift;
 
@@ -489,16 +490,19 @@ ucs_pgt_region_t *ucs_pgtable_lookup(const ucs_pgtable_t *pgtable,
         return NULL;
     }
 
-    /* Descend into the page table */
+    /* Descend into the page table. Every entry is read only once, so the
+     * lookup sees either the old or the new value of an entry which is
+     * updated concurrently. */
     pte   = &pgtable->root;
     shift = pgtable->shift;
     for (;;) {
-        if (ucs_pgt_entry_test(pte, UCS_PGT_ENTRY_FLAG_REGION)) {
-            region = ucs_pgt_entry_get_region(pte);
+        entry.value = *(volatile const ucs_pgt_addr_t*)&pte->value;
+        if (ucs_pgt_entry_test(&entry, UCS_PGT_ENTRY_FLAG_REGION)) {
+            region = ucs_pgt_entry_get_region(&entry);
             ucs_assert((address >= region->start) && (address < region->end));
             return region;
-        } else if (ucs_pgt_entry_test(pte, UCS_PGT_ENTRY_FLAG_DIR)) {
-            dir = ucs_pgt_entry_get_dir(pte);
+        } else if (ucs_pgt_entry_test(&entry, UCS_PGT_ENTRY_FLAG_DIR)) {
+            dir = ucs_pgt_entry_get_dir(&entry);
             shift -= UCS_PGT_ENTRY_SHIFT;
             pte = &dir->entries[(address >> shift) & UCS_PGT_ENTRY_MASK];
         } else {
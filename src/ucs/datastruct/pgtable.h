@@ -200,6 +200,10 @@ ucs_status_t ucs_pgtable_remove(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
 /*
  * Find a region which contains the given address.
  *
+ * The lookup may run concurrently with updates of the page table, if it's
+ * given a consistent copy of the page table structure, and the directories
+ * released by the updates are not reused until the lookup is done.
+ *
  * @param [in]  pgtable     Page table to search the address in.
  * @param [in]  address     Address to search.
  *
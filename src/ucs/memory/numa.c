@@ -12,6 +12,8 @@
 
 #include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
+#include <ucs/sys/math.h>
+#include <ucs/sys/sys.h>
 #include <stdint.h>
 #include <sched.h>
 
@@ -66,9 +68,97 @@ int ucs_numa_node_of_cpu(int cpu)
     ucs_assert(cpu < __CPU_SETSIZE);
 
     if (cpu_numa_nodes[cpu] == 0) {
+        if (numa_available() < 0) {
+            return -1;
+        }
+
         ucs_numa_populate_cpumap(cpu_numa_nodes);
     }
     return cpu_numa_nodes[cpu] - 1;
 }
 
+int ucs_numa_current_node()
+{
+    int cpu;
+
+    cpu = sched_getcpu();
+    if (cpu < 0) {
+        return -1;
+    }
+
+    return ucs_numa_node_of_cpu(cpu);
+}
+
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_policy_t policy, int node)
+{
+    size_t page_size = ucs_get_page_size();
+    struct bitmask *nodemask;
+    uintptr_t start, end;
+    ucs_status_t status;
+    int mode, ret;
+
+    switch (policy) {
+    case UCS_NUMA_POLICY_DEFAULT:
+        return UCS_OK;
+    case UCS_NUMA_POLICY_BIND:
+        mode = MPOL_BIND;
+        break;
+    case UCS_NUMA_POLICY_PREFERRED:
+        mode = MPOL_PREFERRED;
+        break;
+    default:
+        ucs_error("unexpected numa policy %d", policy);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if ((node < 0) || (numa_available() < 0)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    nodemask = numa_allocate_nodemask();
+    if (nodemask == NULL) {
+        ucs_warn("Failed to allocate numa node mask");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    numa_bitmask_clearall(nodemask);
+    numa_bitmask_setbit(nodemask, node);
+
+    start = ucs_align_down_pow2((uintptr_t)address, page_size);
+    end   = ucs_align_up_pow2((uintptr_t)address + length, page_size);
+    ret   = mbind((void*)start, end - start, mode, numa_nodemask_p(nodemask),
+                  numa_nodemask_size(nodemask), MPOL_MF_MOVE);
+    if (ret < 0) {
+        ucs_debug("mbind(addr=0x%lx length=%ld policy=%s node=%d) failed: %m",
+                  start, end - start, ucs_numa_policy_names[policy], node);
+        status = UCS_ERR_IO_ERROR;
+    } else {
+        ucs_trace("0x%lx..0x%lx: set numa policy %s on node %d", start, end,
+                  ucs_numa_policy_names[policy], node);
+        status = UCS_OK;
+    }
+
+    numa_free_nodemask(nodemask);
+    return status;
+}
+
+#else
+
+int ucs_numa_node_of_cpu(int cpu)
+{
+    return -1;
+}
+
+int ucs_numa_current_node()
+{
+    return -1;
+}
+
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_policy_t policy, int node)
+{
+    return (policy == UCS_NUMA_POLICY_DEFAULT) ? UCS_OK : UCS_ERR_UNSUPPORTED;
+}
+
 #endif
@@ -12,6 +12,7 @@
 #endif
 
 #include <ucs/debug/memtrack.h>
+#include <ucs/type/status.h>
 
 #if HAVE_NUMA
 #include <numaif.h>
@@ -59,7 +60,34 @@ typedef enum {
 extern const char *ucs_numa_policy_names[];
 
 
+/**
+ * @return NUMA node of the given CPU, or -1 if it cannot be determined.
+ */
 int ucs_numa_node_of_cpu(int cpu);
 
 
+/**
+ * @return NUMA node of the CPU the calling thread is currently running on, or
+ *         -1 if it cannot be determined.
+ */
+int ucs_numa_current_node();
+
+
+/**
+ * Apply a NUMA memory policy to an address range, and move the pages which were
+ * already allocated in that range to the given node.
+ *
+ * @param [in]  address   Start of the memory range.
+ * @param [in]  length    Length of the memory range.
+ * @param [in]  policy    Memory policy to apply. UCS_NUMA_POLICY_DEFAULT leaves
+ *                        the range unchanged.
+ * @param [in]  node      NUMA node to place the memory on.
+ *
+ * @return UCS_OK if the policy was applied, UCS_ERR_UNSUPPORTED if NUMA is not
+ *         available, or an error code if the operation failed.
+ */
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_policy_t policy, int node);
+
+
 #endif
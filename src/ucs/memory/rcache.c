@@ -16,6 +16,7 @@
 #include <ucs/debug/memtrack.h>
 #include <ucs/stats/stats.h>
 #include <ucs/sys/math.h>
+#include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/type/spinlock.h>
 #include <ucm/api/ucm.h>
@@ -93,6 +94,7 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
         [UCS_RCACHE_PUTS]               = "puts",
         [UCS_RCACHE_REGS]               = "mem_regs",
         [UCS_RCACHE_DEREGS]             = "mem_deregs",
+        [UCS_RCACHE_EVICTS]             = "regions_evicted",
     }
 };
 #endif
@@ -132,6 +134,70 @@ static void __ucs_rcache_region_log(const char *file, int line, const char *func
                      region_desc);
 }
 
+static UCS_F_ALWAYS_INLINE ucs_rcache_epoch_slot_t *
+ucs_rcache_epoch_enter(ucs_rcache_t *rcache, unsigned *parity_p)
+{
+    /* pthread_t is a pointer, hash it to spread the threads over the slots */
+    uint64_t hash                 = (uintptr_t)pthread_self() *
+                                    0x9e3779b97f4a7c15ul;
+    ucs_rcache_epoch_slot_t *slot = &rcache->epoch.slots[
+                                        hash >> (64 - UCS_RCACHE_EPOCH_SLOTS_LOG)];
+    unsigned parity;
+
+    for (;;) {
+        parity = rcache->epoch.current & 1;
+        /* The atomic operation is a full memory barrier, so the lookup which
+         * follows cannot be reordered before it */
+        ucs_atomic_add32(&slot->readers[parity], 1);
+        if (ucs_likely((rcache->epoch.current & 1) == parity)) {
+            *parity_p = parity;
+            return slot;
+        }
+
+        /* Epoch was switched before we were counted, so the thread which
+         * switched it could have missed us - try again */
+        ucs_atomic_sub32(&slot->readers[parity], 1);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_epoch_exit(ucs_rcache_epoch_slot_t *slot, unsigned parity)
+{
+    ucs_atomic_sub32(&slot->readers[parity], 1);
+}
+
+/* Lock must be held in write mode (or use it during cleanup).
+ * Wait until all lookups which could see a region or a page table directory
+ * removed from the page table by now are done, so it can be released. */
+static void ucs_rcache_epoch_sync(ucs_rcache_t *rcache)
+{
+    unsigned parity, i;
+
+    /* The atomic operation also makes the page table updates visible before
+     * reading the counters. New lookups are counted in the other parity, so
+     * the counters we wait for can only go down. */
+    parity = ucs_atomic_fadd32(&rcache->epoch.current, 1) & 1;
+    for (i = 0; i < UCS_RCACHE_EPOCH_SLOTS; ++i) {
+        while (rcache->epoch.slots[i].readers[parity] != 0) {
+            sched_yield();
+        }
+    }
+}
+
+/* Lock must be held in write mode */
+static UCS_F_ALWAYS_INLINE void ucs_rcache_pgt_update_begin(ucs_rcache_t *rcache)
+{
+    ++rcache->pgt_seq;
+    ucs_memory_cpu_store_fence();
+}
+
+/* Lock must be held in write mode */
+static UCS_F_ALWAYS_INLINE void ucs_rcache_pgt_update_end(ucs_rcache_t *rcache)
+{
+    ucs_memory_cpu_store_fence();
+    ++rcache->pgt_seq;
+}
+
 static ucs_pgt_dir_t *ucs_rcache_pgt_dir_alloc(const ucs_pgtable_t *pgtable)
 {
     ucs_rcache_t *rcache = ucs_container_of(pgtable, ucs_rcache_t, pgtable);
@@ -149,6 +215,9 @@ static void ucs_rcache_pgt_dir_release(const ucs_pgtable_t *pgtable,
 {
     ucs_rcache_t *rcache = ucs_container_of(pgtable, ucs_rcache_t, pgtable);
 
+    /* A lock-free lookup may still be walking the directory */
+    ucs_rcache_epoch_sync(rcache);
+
     ucs_spin_lock(&rcache->lock);
     ucs_mpool_put(dir);
     ucs_spin_unlock(&rcache->lock);
@@ -205,6 +274,57 @@ static unsigned ucs_rcache_region_page_count(ucs_rcache_region_t *region)
             ucs_get_page_size();
 }
 
+static UCS_F_ALWAYS_INLINE int ucs_rcache_is_bounded(ucs_rcache_t *rcache)
+{
+    return (rcache->params.max_regions != UCS_ULUNITS_INF) ||
+           (rcache->params.max_size != UCS_MEMUNITS_INF);
+}
+
+/* Lock must be held in write mode */
+static void ucs_rcache_lru_add(ucs_rcache_t *rcache,
+                               ucs_rcache_region_t *region)
+{
+    ucs_spin_lock(&rcache->lru.lock);
+    ucs_list_add_tail(&rcache->lru.list, &region->lru_list);
+    ucs_spin_unlock(&rcache->lru.lock);
+
+    ++rcache->lru.count;
+    rcache->lru.size += region->super.end - region->super.start;
+}
+
+/* Lock must be held in write mode */
+static void ucs_rcache_lru_remove(ucs_rcache_t *rcache,
+                                  ucs_rcache_region_t *region)
+{
+    ucs_spin_lock(&rcache->lru.lock);
+    ucs_list_del(&region->lru_list);
+    /* mark as removed, for a concurrent ucs_rcache_lru_touch() */
+    ucs_list_head_init(&region->lru_list);
+    ucs_spin_unlock(&rcache->lru.lock);
+
+    ucs_assert(rcache->lru.count > 0);
+    --rcache->lru.count;
+    rcache->lru.size -= region->super.end - region->super.start;
+}
+
+/* Region must be held. Move the region to the tail of the LRU list, unless it
+ * was removed from the page table in the meanwhile. */
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_lru_touch(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
+{
+    if (!ucs_rcache_is_bounded(rcache)) {
+        /* the order is used only for eviction */
+        return;
+    }
+
+    ucs_spin_lock(&rcache->lru.lock);
+    if (!ucs_list_is_empty(&region->lru_list)) {
+        ucs_list_del(&region->lru_list);
+        ucs_list_add_tail(&rcache->lru.list, &region->lru_list);
+    }
+    ucs_spin_unlock(&rcache->lru.lock);
+}
+
 static void ucs_rcache_validate_pfn(ucs_rcache_t *rcache,
                                     ucs_rcache_region_t *region,
                                     unsigned page_num,
@@ -231,7 +351,7 @@ static void ucs_rcache_region_validate_pfn_cb(unsigned page_num,
                             pfn);
 }
 
-/* Lock must be held for read */
+/* Region must be held */
 static void ucs_rcache_region_validate_pfn(ucs_rcache_t *rcache,
                                            ucs_rcache_region_t *region)
 {
@@ -309,6 +429,9 @@ static void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         ucs_free(ucs_rcache_region_pfn_ptr(region));
     }
 
+    /* A lock-free lookup may have found the region before it was removed from
+     * the page table */
+    ucs_rcache_epoch_sync(rcache);
     ucs_free(region);
 }
 
@@ -358,11 +481,14 @@ static void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
 
     /* Remove the memory region from page table, if it's there */
     if (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) {
+        ucs_rcache_pgt_update_begin(rcache);
         status = ucs_pgtable_remove(&rcache->pgtable, &region->super);
+        ucs_rcache_pgt_update_end(rcache);
         if (status != UCS_OK) {
             ucs_rcache_region_warn(rcache, region, "failed to remove (%s)",
                                    ucs_status_string(status));
         }
+        ucs_rcache_lru_remove(rcache, region);
         region->flags &= ~UCS_RCACHE_REGION_FLAG_PGTABLE;
     } else {
         ucs_assert(!(flags & UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE));
@@ -389,6 +515,39 @@ static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache, ucs_pgt_addr_t sta
     }
 }
 
+/* Lock must be held in write mode.
+ * Invalidate unused regions, starting from the least recently used one, until
+ * a region of 'length' bytes can be added without exceeding the given limits.
+ * Returns the number of evicted regions. */
+static unsigned ucs_rcache_lru_evict(ucs_rcache_t *rcache, size_t length,
+                                     unsigned long max_regions, size_t max_size)
+{
+    ucs_rcache_region_t *region, *tmp;
+    unsigned num_evicted = 0;
+
+    ucs_list_for_each_safe(region, tmp, &rcache->lru.list, lru_list) {
+        if ((rcache->lru.count < max_regions) &&
+            ((rcache->lru.size + length) <= max_size)) {
+            break;
+        }
+
+        if (region->refcount > 1) {
+            /* region is in use, other than by the page table */
+            continue;
+        }
+
+        /* a lock-free lookup may still take a reference to the region, so
+         * it's not necessarily destroyed here */
+        ucs_rcache_region_trace(rcache, region, "evict");
+        ucs_rcache_region_invalidate(rcache, region,
+                                     UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE);
+        ++num_evicted;
+    }
+
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_EVICTS, num_evicted);
+    return num_evicted;
+}
+
 /* Lock must be held in write mode */
 static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
 {
@@ -504,10 +663,13 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
     ucs_trace_func("rcache=%s", rcache->name);
 
     ucs_list_head_init(&region_list);
+    ucs_rcache_pgt_update_begin(rcache);
     ucs_pgtable_purge(&rcache->pgtable, ucs_rcache_region_collect_callback,
                       &region_list);
+    ucs_rcache_pgt_update_end(rcache);
     ucs_list_for_each_safe(region, tmp, &region_list, list) {
         if (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) {
+            ucs_rcache_lru_remove(rcache, region);
             region->flags &= ~UCS_RCACHE_REGION_FLAG_PGTABLE;
             ucs_atomic_add32(&region->refcount, (uint32_t)-1);
         }
@@ -652,13 +814,14 @@ ucs_rcache_create_region(ucs_rcache_t *rcache, void *address, size_t length,
 {
     ucs_rcache_region_t *region;
     ucs_pgt_addr_t start, end;
-    ucs_status_t status;
-    int error, merged;
+    ucs_status_t status, watch_status;
+    int error, merged, evicted, hide_errors;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
     pthread_rwlock_wrlock(&rcache->pgt_lock);
+    evicted = 0;
 
 retry:
     /* Align to page size */
@@ -677,6 +840,7 @@ retry:
          * the lock)
          */
         ucs_rcache_region_validate_pfn(rcache, region);
+        ucs_rcache_lru_touch(rcache, region);
         status = region->status;
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_SLOW, 1);
         goto out_set_region;
@@ -687,6 +851,16 @@ retry:
         goto out_unlock;
     }
 
+    /* Make room for the new region */
+    if (ucs_rcache_is_bounded(rcache)) {
+        ucs_rcache_lru_evict(rcache, end - start, rcache->params.max_regions,
+                             rcache->params.max_size);
+    }
+
+    /* If registration fails while other unused regions are cached, they will
+     * be evicted and the registration retried, so don't report the error */
+    hide_errors = merged || (!evicted && (rcache->lru.count > 0));
+
     /* Allocate structure for new region */
     error = ucs_posix_memalign((void **)&region,
                                ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
@@ -700,28 +874,35 @@ retry:
 
     memset(region, 0, rcache->params.region_struct_size);
 
+    /* The region becomes visible to lock-free lookups once it's inserted to
+     * the page table, but they will not use it before it's registered */
     region->super.start = start;
     region->super.end   = end;
+    region->prot        = prot;
+    region->flags       = UCS_RCACHE_REGION_FLAG_PGTABLE;
+    region->refcount    = 1;
+    ucs_rcache_pgt_update_begin(rcache);
     status = UCS_PROFILE_CALL(ucs_pgtable_insert, &rcache->pgtable, &region->super);
+    ucs_rcache_pgt_update_end(rcache);
     if (status != UCS_OK) {
         ucs_error("failed to insert region " UCS_PGT_REGION_FMT ": %s",
                   UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
+        ucs_rcache_epoch_sync(rcache);
         ucs_free(region);
         goto out_unlock;
     }
 
+    ucs_rcache_lru_add(rcache, region);
+
     /* If memory registration failed, keep the region and mark it as invalid,
      * to avoid numerous retries of registering the region.
      */
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_REGS, 1);
 
-    region->prot     = prot;
-    region->flags    = UCS_RCACHE_REGION_FLAG_PGTABLE;
-    region->refcount = 1;
     region->status = status =
         UCS_PROFILE_NAMED_CALL("mem_reg", rcache->params.ops->mem_reg,
                                rcache->params.context, rcache, arg, region,
-                               merged ? UCS_RCACHE_MEM_REG_HIDE_ERRORS : 0);
+                               hide_errors ? UCS_RCACHE_MEM_REG_HIDE_ERRORS : 0);
     if (status != UCS_OK) {
         if (merged) {
             /* failure may be due to merge, because memory of the merged
@@ -736,6 +917,19 @@ retry:
                                          UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE |
                                          UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY);
             goto retry;
+        } else if (hide_errors) {
+            /* memory pressure: the registration may have failed because of
+             * resources held by unused regions, so evict them and retry */
+            ucs_debug("failed to register region " UCS_PGT_REGION_FMT ": %s, "
+                      "retrying after evicting unused regions",
+                      UCS_PGT_REGION_ARG(&region->super),
+                      ucs_status_string(status));
+            ucs_rcache_region_invalidate(rcache, region,
+                                         UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE |
+                                         UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY);
+            ucs_rcache_lru_evict(rcache, 0, 0, 0);
+            evicted = 1;
+            goto retry;
         } else {
             ucs_debug("failed to register region " UCS_PGT_REGION_FMT ": %s",
                       UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
@@ -743,9 +937,6 @@ retry:
         }
     }
 
-    region->flags   |= UCS_RCACHE_REGION_FLAG_REGISTERED;
-    region->refcount = 2; /* Page-table + user */
-
     if (!(rcache->params.flags & UCS_RCACHE_FLAG_NO_PFN_CHECK)) {
         status = ucs_rcache_fill_pfn(region);
         if (status != UCS_OK) {
@@ -755,6 +946,27 @@ retry:
         }
     }
 
+    /* Page-table + user. A lock-free lookup may take a reference as soon as
+     * the region is marked as registered, so add ours atomically. */
+    ucs_atomic_add32(&region->refcount, +1);
+    ucs_memory_cpu_store_fence();
+    region->flags |= UCS_RCACHE_REGION_FLAG_REGISTERED;
+
+    /* With userfaultfd-based events, an unmap is reported only for ranges
+     * which were explicitly watched. If that fails, we would never learn the
+     * memory is gone, so hand the region to the user without caching it. */
+    if (rcache->params.ucm_events & UCM_EVENT_VM_UNMAPPED) {
+        watch_status = ucm_vm_watch((void*)region->super.start,
+                                    region->super.end - region->super.start);
+        if ((watch_status != UCS_OK) &&
+            (watch_status != UCS_ERR_UNSUPPORTED)) {
+            ucs_rcache_region_debug(rcache, region, "not cached: %s",
+                                    ucs_status_string(watch_status));
+            ucs_rcache_region_invalidate(rcache, region,
+                                         UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE);
+        }
+    }
+
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_MISSES, 1);
 
     ucs_rcache_region_trace(rcache, region, "created");
@@ -772,41 +984,97 @@ void ucs_rcache_region_hold(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
     ucs_rcache_region_trace(rcache, region, "hold");
 }
 
+/*
+ * Find a registered region which contains the given range, without taking
+ * 'pgt_lock', and take a reference to it.
+ * Return NULL if the region was not found, or the page table is being updated.
+ */
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_lookup_unlocked(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                           size_t length, int prot)
+{
+    ucs_rcache_epoch_slot_t *slot;
+    ucs_pgt_region_t *pgt_region;
+    ucs_rcache_region_t *region;
+    ucs_pgtable_t pgtable;
+    uint32_t refcount;
+    unsigned parity, seq;
+
+    slot = ucs_rcache_epoch_enter(rcache, &parity);
+
+    /* Take a consistent copy of the page table root. The directories below it
+     * are not released until we exit the epoch. */
+    seq = rcache->pgt_seq;
+    ucs_memory_cpu_load_fence();
+    pgtable = rcache->pgtable;
+    ucs_memory_cpu_load_fence();
+    if ((seq & 1) || (seq != rcache->pgt_seq)) {
+        region = NULL;
+        goto out;
+    }
+
+    pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &pgtable, start);
+    if (pgt_region == NULL) {
+        region = NULL;
+        goto out;
+    }
+
+    region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
+    if (((start + length) > region->super.end) ||
+        !ucs_rcache_region_test(region, prot)) {
+        region = NULL;
+        goto out;
+    }
+
+    /* The region may be concurrently removed from the page table and
+     * destroyed, so don't take a reference if it's already released */
+    do {
+        refcount = region->refcount;
+        if (refcount == 0) {
+            region = NULL;
+            goto out;
+        }
+    } while (ucs_atomic_cswap32(&region->refcount, refcount,
+                                refcount + 1) != refcount);
+
+out:
+    ucs_rcache_epoch_exit(slot, parity);
+    return region;
+}
+
 ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                             int prot, void *arg, ucs_rcache_region_t **region_p)
 {
-    ucs_pgt_addr_t start = (uintptr_t)address;
-    ucs_pgt_region_t *pgt_region;
     ucs_rcache_region_t *region;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_rdlock(&rcache->pgt_lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
     if (ucs_queue_is_empty(&rcache->inv_q)) {
-        pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable,
-                                      start);
-        if (ucs_likely(pgt_region != NULL)) {
-            region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
-            if (((start + length) <= region->super.end) &&
-                ucs_rcache_region_test(region, prot))
-            {
-                ucs_rcache_region_hold(rcache, region);
+        region = ucs_rcache_lookup_unlocked(rcache, (uintptr_t)address, length,
+                                            prot);
+        if (ucs_likely(region != NULL)) {
+            if (ucs_likely(region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE)) {
+                ucs_rcache_region_trace(rcache, region, "hold");
                 ucs_rcache_region_validate_pfn(rcache, region);
+                ucs_rcache_lru_touch(rcache, region);
                 *region_p = region;
                 UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
-                pthread_rwlock_unlock(&rcache->pgt_lock);
                 return UCS_OK;
             }
+
+            /* The region was invalidated after we found it */
+            ucs_rcache_region_put_internal(rcache, region,
+                                           UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
         }
     }
-    pthread_rwlock_unlock(&rcache->pgt_lock);
 
     /* Fall back to slow version (with rw lock) in following cases:
      * - invalidation list not empty
      * - could not find cached region
      * - found unregistered region
+     * - the page table is being updated
      */
     return UCS_PROFILE_CALL(ucs_rcache_create_region, rcache, address, length,
                             prot, arg, region_p);
@@ -932,10 +1200,19 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_destroy_rwlock;
     }
 
+    status = ucs_spinlock_init(&self->lru.lock, 0);
+    if (status != UCS_OK) {
+        goto err_destroy_inv_q_lock;
+    }
+
+    self->pgt_seq       = 0;
+    self->epoch.current = 0;
+    memset(self->epoch.slots, 0, sizeof(self->epoch.slots));
+
     status = ucs_pgtable_init(&self->pgtable, ucs_rcache_pgt_dir_alloc,
                               ucs_rcache_pgt_dir_release);
     if (status != UCS_OK) {
-        goto err_destroy_inv_q_lock;
+        goto err_destroy_lru_lock;
     }
 
     mp_obj_size = ucs_max(sizeof(ucs_pgt_dir_t), sizeof(ucs_rcache_inv_entry_t));
@@ -948,6 +1225,9 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
 
     ucs_queue_head_init(&self->inv_q);
     ucs_list_head_init(&self->gc_list);
+    ucs_list_head_init(&self->lru.list);
+    self->lru.count = 0;
+    self->lru.size  = 0;
 
     status = ucm_set_event_handler(params->ucm_events, params->ucm_event_priority,
                                    ucs_rcache_unmapped_callback, self);
@@ -969,6 +1249,11 @@ err_destroy_mp:
     ucs_mpool_cleanup(&self->mp, 1);
 err_cleanup_pgtable:
     ucs_pgtable_cleanup(&self->pgtable);
+err_destroy_lru_lock:
+    spinlock_status = ucs_spinlock_destroy(&self->lru.lock);
+    if (spinlock_status != UCS_OK) {
+        ucs_warn("ucs_spinlock_destroy() failed (%d)", spinlock_status);
+    }
 err_destroy_inv_q_lock:
     spinlock_status = ucs_spinlock_destroy(&self->lock);
     if (spinlock_status != UCS_OK) {
@@ -997,6 +1282,11 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
 
     ucs_mpool_cleanup(&self->mp, 1);
     ucs_pgtable_cleanup(&self->pgtable);
+    ucs_assert(self->lru.count == 0);
+    status = ucs_spinlock_destroy(&self->lru.lock);
+    if (status != UCS_OK) {
+        ucs_warn("ucs_spinlock_destroy() failed (%d)", status);
+    }
     status = ucs_spinlock_destroy(&self->lock);
     if (status != UCS_OK) {
         ucs_warn("ucs_recursive_spinlock_destroy() failed (%d)", status);
@@ -122,12 +122,20 @@ struct ucs_rcache_params {
     void                   *context;            /**< User-defined context that will
                                                      be passed to mem_reg/mem_dereg */
     int                    flags;               /**< Flags */
+    unsigned long          max_regions;         /**< Maximal number of regions
+                                                     in the cache, or
+                                                     UCS_ULUNITS_INF */
+    size_t                 max_size;            /**< Maximal total size of the
+                                                     regions in the cache, or
+                                                     UCS_MEMUNITS_INF */
 };
 
 
 struct ucs_rcache_region {
     ucs_pgt_region_t       super;    /**< Base class - page table region */
     ucs_list_link_t        list;     /**< List element */
+    ucs_list_link_t        lru_list; /**< LRU list element, valid while the
+                                          region is in the page table */
     volatile uint32_t      refcount; /**< Reference count, including +1 if it's
                                           in the page table */
     ucs_status_t           status;   /**< Current status code */
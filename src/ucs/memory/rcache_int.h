@@ -7,9 +7,17 @@
 #ifndef UCS_REG_CACHE_INT_H_
 #define UCS_REG_CACHE_INT_H_
 
+#include <ucs/arch/cpu.h>
+#include <ucs/sys/compiler.h>
 #include <ucs/type/spinlock.h>
 
 
+/* Number of reader counters used by lock-free lookups. Threads are hashed to
+ * the counters, so a counter may be shared by several threads. */
+#define UCS_RCACHE_EPOCH_SLOTS_LOG   6
+#define UCS_RCACHE_EPOCH_SLOTS       UCS_BIT(UCS_RCACHE_EPOCH_SLOTS_LOG)
+
+
 /* Names of rcache stats counters */
 enum {
     UCS_RCACHE_GETS,                /* number of get operations */
@@ -23,16 +31,39 @@ enum {
     UCS_RCACHE_PUTS,                /* number of put operations */
     UCS_RCACHE_REGS,                /* number of memory registrations */
     UCS_RCACHE_DEREGS,              /* number of memory deregistrations */
+    UCS_RCACHE_EVICTS,              /* number of unused regions evicted
+                                       because of the cache size limits */
     UCS_RCACHE_STAT_LAST
 };
 
 
+typedef struct ucs_rcache_epoch_slot {
+    volatile uint32_t        readers[2]; /**< Number of lookups in progress,
+                                              per epoch parity */
+    UCS_CACHELINE_PADDING(uint32_t[2]);
+} ucs_rcache_epoch_slot_t;
+
+
 struct ucs_rcache {
     ucs_rcache_params_t      params;   /**< rcache parameters (immutable) */
 
-    pthread_rwlock_t         pgt_lock; /**< Protects the page table and all
-                                            regions whose refcount is 0 */
+    pthread_rwlock_t         pgt_lock; /**< Serializes updates of the page table
+                                            and protects all regions whose
+                                            refcount is 0. Cache hits do not
+                                            take it, see 'epoch'. */
     ucs_pgtable_t            pgtable;  /**< page table to hold the regions */
+    volatile unsigned        pgt_seq;  /**< Page table update sequence number,
+                                            odd while an update is in progress */
+
+    struct {
+        volatile uint32_t    current;  /**< Lookups enter epoch (current & 1) */
+        ucs_rcache_epoch_slot_t slots[UCS_RCACHE_EPOCH_SLOTS]; /**< Counters
+                                            of lookups in progress. Regions and
+                                            page table directories removed from
+                                            the page table are released only
+                                            after the lookups which could see
+                                            them are done. */
+    } epoch;
 
 
     ucs_spinlock_t           lock;     /**< Protects 'mp', 'inv_q' and 'gc_list'.
@@ -52,6 +83,17 @@ struct ucs_rcache {
     ucs_list_link_t          gc_list;  /**< list for regions to destroy, regions
                                             could not be destroyed from memhook */
 
+    struct {
+        ucs_spinlock_t       lock;     /**< Protects 'list' against concurrent
+                                            updates from the lookup fast path,
+                                            which does not hold 'pgt_lock' */
+        ucs_list_link_t      list;     /**< Regions in the page table, from the
+                                            least to the most recently used */
+        unsigned long        count;    /**< Number of regions in the page table */
+        size_t               size;     /**< Total size of regions in the page
+                                            table */
+    } lru;
+
     char                     *name;    /**< Name of the cache, for debug purpose */
     UCS_STATS_NODE_DECLARE(stats)
 
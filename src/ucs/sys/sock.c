@@ -425,7 +425,7 @@ ucs_socket_handle_io_error(int fd, const char *name, ssize_t io_retval, int io_e
     if (io_retval == 0) {
         /* 0 can be returned only by recv() system call as an error if
          * the connection was dropped by peer */
-        ucs_assert(!strcmp(name, "recv"));
+        ucs_assert(!strcmp(name, "recv") || !strcmp(name, "recvv"));
         ucs_trace("fd %d is closed", fd);
         status = UCS_ERR_NOT_CONNECTED; /* Connection closed by peer */
     } else {
@@ -556,6 +556,43 @@ ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p)
     return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv");
 }
 
+ucs_status_t ucs_socket_sendmsg_nb(int fd, struct iovec *iov, size_t iov_cnt,
+                                   int flags, size_t *length_p)
+{
+    struct msghdr msg = {
+        .msg_iov    = iov,
+        .msg_iovlen = iov_cnt
+    };
+    ssize_t ret;
+
+    ret = sendmsg(fd, &msg, MSG_NOSIGNAL | flags);
+    if (ucs_unlikely((ret < 0) && (errno == ENOBUFS))) {
+        /* The kernel failed to allocate resources for the operation (e.g. to
+         * pin user's pages for MSG_ZEROCOPY), the caller may retry it without
+         * the additional flags */
+        *length_p = 0;
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    return ucs_socket_handle_io(fd, iov, iov_cnt, length_p, 1, ret, errno,
+                                "sendmsg");
+}
+
+/* recvmsg() takes non-const message header, wrap it to match the prototype of
+ * the IOV function */
+static ssize_t
+ucs_socket_recvmsg_io(int fd, const struct msghdr *msg, int flags)
+{
+    return recvmsg(fd, (struct msghdr*)msg, flags);
+}
+
+ucs_status_t
+ucs_socket_recvv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p)
+{
+    return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p,
+                                ucs_socket_recvmsg_io, "recvv");
+}
+
 ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
 {
     switch (addr->sa_family) {
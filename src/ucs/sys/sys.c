@@ -26,6 +26,7 @@
 #include <sys/shm.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <dirent.h>
 #include <sched.h>
@@ -46,6 +47,7 @@
 #define UCS_PROCESS_BOOTID_FMT     "%x-%4hx-%4hx-%4hx-%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx"
 #define UCS_PROCESS_NS_FIRST       0xF0000000U
 #define UCS_PROCESS_NS_NET_DFLT    0xF0000080U
+#define UCS_SYS_MEM_PROBE_MAX_IOV  64
 
 
 struct {
@@ -979,6 +981,60 @@ int ucs_get_mem_prot(unsigned long start, unsigned long end)
     return ctx.prot;
 }
 
+ucs_status_t ucs_sys_check_mem_readable(const void *address, size_t length)
+{
+#ifdef HAVE_PROCESS_VM_READV
+    char buffer[UCS_SYS_MEM_PROBE_MAX_IOV];
+    struct iovec remote_iov[UCS_SYS_MEM_PROBE_MAX_IOV];
+    struct iovec local_iov;
+    size_t page_size;
+    uintptr_t start, end;
+    unsigned iov_cnt;
+    ssize_t ret;
+
+    if (length == 0) {
+        return UCS_OK;
+    }
+
+    start = (uintptr_t)address;
+    end   = start + length;
+    if (end < start) {
+        return UCS_ERR_INVALID_ADDR;
+    }
+
+    /* Read one byte of every page through the kernel, which fails with
+     * EFAULT instead of raising a signal if the page is not accessible */
+    page_size = ucs_get_page_size();
+    while (start < end) {
+        for (iov_cnt = 0; (iov_cnt < UCS_SYS_MEM_PROBE_MAX_IOV) && (start < end);
+             ++iov_cnt) {
+            remote_iov[iov_cnt].iov_base = (void*)start;
+            remote_iov[iov_cnt].iov_len  = 1;
+            start = ucs_align_down_pow2(start, page_size) + page_size;
+        }
+
+        local_iov.iov_base = buffer;
+        local_iov.iov_len  = iov_cnt;
+        ret = process_vm_readv(getpid(), &local_iov, 1, remote_iov, iov_cnt, 0);
+        if (ret < 0) {
+            if (errno == EFAULT) {
+                return UCS_ERR_INVALID_ADDR;
+            }
+
+            ucs_debug("process_vm_readv() failed: %m");
+            return UCS_ERR_UNSUPPORTED;
+        } else if (ret != iov_cnt) {
+            /* The read stops on the first page which is not accessible */
+            return UCS_ERR_INVALID_ADDR;
+        }
+    }
+
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 const char* ucs_get_process_cmdline()
 {
     static char cmdline[1024] = {0};
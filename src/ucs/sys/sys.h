@@ -359,6 +359,22 @@ ucs_status_t ucs_mmap_free(void *address, size_t length);
 int ucs_get_mem_prot(unsigned long start, unsigned long end);
 
 
+/**
+ * Check that a memory region can be read by the current process, without
+ * accessing it directly. Unlike @ref ucs_get_mem_prot, the check does not
+ * parse the memory map of the process, so it is cheap enough to be used on
+ * the data path.
+ *
+ * @param address Region start.
+ * @param length  Region length.
+ *
+ * @return UCS_OK if the region is readable, UCS_ERR_INVALID_ADDR if a part of
+ *         it is not mapped or not readable, UCS_ERR_UNSUPPORTED if the check
+ *         is not supported by the system.
+ */
+ucs_status_t ucs_sys_check_mem_readable(const void *address, size_t length);
+
+
 /**
  * Returns the physical page frame number of a given virtual page address.
  * If the page map file is non-readable (for example, due to permissions), or
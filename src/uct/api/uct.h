@@ -967,6 +967,9 @@ struct uct_iface_attr {
                                                 achieve higher total bandwidth
                                                 compared to using only a single
                                                 endpoint. */
+    int                      numa_node;    /**< NUMA node the interface's receive
+                                                resources are placed on, or -1
+                                                if not bound to a specific node. */
 };
 
 
@@ -39,6 +39,17 @@ ucs_config_field_t uct_md_config_rcache_table[] = {
      "between "UCS_PP_MAKE_STRING(UCS_PGT_ADDR_ALIGN)"and system page size",
      ucs_offsetof(uct_md_rcache_config_t, alignment), UCS_CONFIG_TYPE_UINT},
 
+    {"RCACHE_MAX_REGIONS", "inf",
+     "Maximal number of regions in the registration cache. When the limit is\n"
+     "reached, unused regions are deregistered in least recently used order.",
+     ucs_offsetof(uct_md_rcache_config_t, max_regions), UCS_CONFIG_TYPE_ULUNITS},
+
+    {"RCACHE_MAX_SIZE", "inf",
+     "Maximal total size of the regions in the registration cache. When the\n"
+     "limit is reached, unused regions are deregistered in least recently used\n"
+     "order.",
+     ucs_offsetof(uct_md_rcache_config_t, max_size), UCS_CONFIG_TYPE_MEMUNITS},
+
     {NULL}
 };
 
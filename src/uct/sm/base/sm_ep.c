@@ -8,7 +8,9 @@
 #endif
 
 #include "sm_ep.h"
+#include "sm_iface.h"
 
+#include <uct/base/uct_iov.inl>
 #include <ucs/arch/atomic.h>
 
 
@@ -58,6 +60,27 @@ ucs_status_t uct_sm_ep_get_bcopy(uct_ep_h tl_ep, uct_unpack_callback_t unpack_cb
     return UCS_OK;
 }
 
+ucs_status_t uct_sm_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                 size_t iovcnt, uint64_t remote_addr,
+                                 uct_rkey_t rkey, uct_completion_t *comp)
+{
+    size_t offset = 0;
+    size_t iov_idx, length;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, (size_t)UCT_SM_MAX_IOV, "uct_sm_ep_get_zcopy");
+
+    for (iov_idx = 0; iov_idx < iovcnt; ++iov_idx) {
+        length = uct_iov_get_length(&iov[iov_idx]);
+        memcpy(iov[iov_idx].buffer, (void*)(rkey + remote_addr + offset),
+               length);
+        offset += length;
+    }
+
+    uct_sm_ep_trace_data(remote_addr, rkey, "GET_ZCOPY [length %zu]", offset);
+    UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), GET, ZCOPY, offset);
+    return UCS_OK;
+}
+
 ucs_status_t uct_sm_ep_atomic32_post(uct_ep_h ep, unsigned opcode, uint32_t value,
                                      uint64_t remote_addr, uct_rkey_t rkey)
 {
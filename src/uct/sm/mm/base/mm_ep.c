@@ -118,6 +118,65 @@ static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
     }
 }
 
+static void uct_mm_ep_ring_notify(uct_mm_ep_t *ep)
+{
+    /* make the element or state change visible before reading the bitmap,
+     * since the receiver clears the bit before polling the ring */
+    ucs_memory_bus_fence();
+    if (!(*ep->ring.active_word & ep->ring.active_bit)) {
+        ucs_atomic_or64(ep->ring.active_word, ep->ring.active_bit);
+    }
+}
+
+/* Take a free sender ring in the remote FIFO segment. If there is no free
+ * ring, the ep sends through the shared FIFO. */
+static void uct_mm_ep_ring_claim(uct_mm_ep_t *ep, uct_mm_iface_t *iface)
+{
+    volatile uint64_t *ring_active;
+    uct_mm_ring_ctl_t *first_ring, *ring_ctl;
+    unsigned i, ring_index;
+
+    ep->ring.ctl   = NULL;
+    ep->ring.ready = 0;
+    if (iface->config.ring_count == 0) {
+        return;
+    }
+
+    first_ring = uct_mm_iface_get_rings_ptrs(iface, ep->fifo_elems,
+                                             &ring_active);
+
+    /* start from a different ring in every process to reduce collisions */
+    for (i = 0; i < iface->config.ring_count; i++) {
+        ring_index = (getpid() + i) % iface->config.ring_count;
+        ring_ctl   = uct_mm_iface_get_ring_ctl(iface, first_ring, ring_index);
+        if ((ring_ctl->state == UCT_MM_RING_STATE_FREE) &&
+            (ucs_atomic_cswap32(ucs_unaligned_ptr(&ring_ctl->state),
+                                UCT_MM_RING_STATE_FREE,
+                                UCT_MM_RING_STATE_CLAIMED) ==
+             UCT_MM_RING_STATE_FREE)) {
+            break;
+        }
+    }
+
+    if (i == iface->config.ring_count) {
+        ucs_debug("mm ep %p: no free sender ring, using the shared FIFO", ep);
+        return;
+    }
+
+    ep->ring.ctl         = ring_ctl;
+    ep->ring.elems       = ring_ctl + 1;
+    ep->ring.active_word = &ring_active[ring_index / 64];
+    ep->ring.active_bit  = UCS_BIT(ring_index % 64);
+    ep->ring.head        = 0;
+    ep->ring.cached_tail = 0;
+    ep->ring.fifo_end    = 0;
+
+    /* let the receiver assign descriptors to the ring. until then, the ep
+     * sends through the FIFO */
+    uct_mm_ep_ring_notify(ep);
+    ucs_debug("mm ep %p: claimed sender ring %u", ep, ring_index);
+}
+
 static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
 {
     uct_mm_iface_t            *iface = ucs_derived_of(params->iface, uct_mm_iface_t);
@@ -160,6 +219,8 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
     self->signal.addrlen  = self->fifo_ctl->signal_addrlen;
     self->signal.sockaddr = self->fifo_ctl->signal_sockaddr;
 
+    uct_mm_ep_ring_claim(self, iface);
+
     ucs_debug("created mm ep %p, connected to remote FIFO id 0x%"PRIx64,
               self, addr->fifo_seg_id);
 
@@ -178,6 +239,13 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_ep_t)
 
     uct_mm_ep_pending_purge(&self->super.super, NULL, NULL);
 
+    if (self->ring.ctl != NULL) {
+        /* the receiver recycles the ring after draining it */
+        ucs_memory_cpu_store_fence();
+        self->ring.ctl->state = UCT_MM_RING_STATE_RELEASED;
+        uct_mm_ep_ring_notify(self);
+    }
+
     kh_foreach_value(&self->remote_segs, remote_seg, {
         uct_mm_iface_mapper_call(iface, mem_detach, &remote_seg);
     })
@@ -211,32 +279,76 @@ static inline ucs_status_t uct_mm_ep_get_remote_elem(uct_mm_ep_t *ep, uint64_t h
     return UCS_OK;
 }
 
+/* Switch to the sender ring when the receiver has activated it, and has
+ * consumed all the elements this ep sent through the FIFO, so the messages
+ * are not reordered */
+static UCS_F_NOINLINE int uct_mm_ep_ring_check_ready(uct_mm_ep_t *ep)
+{
+    if ((ep->ring.ctl->state != UCT_MM_RING_STATE_ACTIVE) ||
+        (ep->fifo_ctl->tail < ep->ring.fifo_end)) {
+        return 0;
+    }
+
+    ucs_memory_cpu_load_fence();
+    ep->ring.cached_tail = ep->ring.ctl->tail;
+    ep->ring.ready       = 1;
+    ucs_debug("mm ep %p: sending through the sender ring", ep);
+    return 1;
+}
+
+static UCS_F_ALWAYS_INLINE int uct_mm_ep_use_ring(uct_mm_ep_t *ep)
+{
+    return ep->ring.ready ||
+           ((ep->ring.ctl != NULL) && uct_mm_ep_ring_check_ready(ep));
+}
+
 static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
 {
     ucs_memory_cpu_load_fence();
-    ep->cached_tail = ep->fifo_ctl->tail;
+    if (ep->ring.ready) {
+        ep->ring.cached_tail = ep->ring.ctl->tail;
+    } else {
+        ep->cached_tail = ep->fifo_ctl->tail;
+    }
 }
 
-/* A common mm active message sending function.
- * The first parameter indicates the origin of the call.
- * is_short = 1 - perform AM short sending
- * is_short = 0 - perform AM bcopy sending
- */
-static UCS_F_ALWAYS_INLINE ssize_t
-uct_mm_ep_am_common_send(uct_mm_send_op_t send_op, uct_mm_ep_t *ep,
-                         uct_mm_iface_t *iface, uint8_t am_id, size_t length,
-                         uint64_t header, const void *payload,
-                         uct_pack_callback_t pack_cb, void *arg,
-                         unsigned flags)
+/* Get the next element of the ep's sender ring */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_mm_ep_get_ring_elem(uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+                        uct_mm_fifo_element_t **elem_p, uint64_t *head_p)
+{
+    uint64_t head = ep->ring.head;
+
+    if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->ring.cached_tail,
+                                   iface->config.ring_size)) {
+        if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
+            /* pending isn't empty. don't send now to prevent out-of-order sending */
+            UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+            return UCS_ERR_NO_RESOURCE;
+        }
+
+        uct_mm_ep_update_cached_tail(ep);
+        if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->ring.cached_tail,
+                                       iface->config.ring_size)) {
+            UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+            return UCS_ERR_NO_RESOURCE;
+        }
+    }
+
+    *elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->ring.elems,
+                                         head & (iface->config.ring_size - 1));
+    *head_p = head;
+    return UCS_OK;
+}
+
+/* Get the next element of the shared remote FIFO */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_mm_ep_get_fifo_elem(uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+                        uct_mm_fifo_element_t **elem_p, uint64_t *head_p)
 {
-    uct_mm_fifo_element_t *elem;
     ucs_status_t status;
-    void *base_address;
-    uint8_t elem_flags;
     uint64_t head;
 
-    UCT_CHECK_AM_ID(am_id);
-
 retry:
     head = ep->fifo_ctl->head;
     /* check if there is room in the remote process's receive FIFO to write */
@@ -256,13 +368,49 @@ retry:
         }
     }
 
-    status = uct_mm_ep_get_remote_elem(ep, head, &elem);
+    status = uct_mm_ep_get_remote_elem(ep, head, elem_p);
     if (status != UCS_OK) {
         ucs_assert(status == UCS_ERR_NO_RESOURCE);
         ucs_trace_poll("couldn't get an available FIFO element. retrying");
         goto retry;
     }
 
+    *head_p = head;
+    return UCS_OK;
+}
+
+/* A common mm active message sending function.
+ * The first parameter indicates the origin of the call.
+ * is_short = 1 - perform AM short sending
+ * is_short = 0 - perform AM bcopy sending
+ */
+static UCS_F_ALWAYS_INLINE ssize_t
+uct_mm_ep_am_common_send(uct_mm_send_op_t send_op, uct_mm_ep_t *ep,
+                         uct_mm_iface_t *iface, uint8_t am_id, size_t length,
+                         uint64_t header, const void *payload,
+                         uct_pack_callback_t pack_cb, void *arg,
+                         unsigned flags)
+{
+    uct_mm_fifo_element_t *elem;
+    ucs_status_t status;
+    void *base_address;
+    uint8_t elem_flags;
+    unsigned size;
+    uint64_t head;
+
+    UCT_CHECK_AM_ID(am_id);
+
+    if (uct_mm_ep_use_ring(ep)) {
+        status = uct_mm_ep_get_ring_elem(ep, iface, &elem, &head);
+        size   = iface->config.ring_size;
+    } else {
+        status = uct_mm_ep_get_fifo_elem(ep, iface, &elem, &head);
+        size   = iface->config.fifo_size;
+    }
+    if (status != UCS_OK) {
+        return status;
+    }
+
     switch (send_op) {
     case UCT_MM_SEND_AM_SHORT:
         /* write to the remote FIFO */
@@ -305,11 +453,18 @@ retry:
 
     /* set the owner bit to indicate that the writing is complete.
      * the owner bit flips after every FIFO wraparound */
-    if (head & iface->config.fifo_size) {
+    if (head & size) {
         elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
     }
     elem->flags = elem_flags;
 
+    if (ep->ring.ready) {
+        ep->ring.head = head + 1;
+        uct_mm_ep_ring_notify(ep);
+    } else if (ep->ring.ctl != NULL) {
+        ep->ring.fifo_end = head + 1;
+    }
+
     if (ucs_unlikely(flags & UCT_SEND_FLAG_SIGNALED)) {
         uct_mm_ep_signal_remote(ep);
     }
@@ -352,6 +507,12 @@ ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_
 static inline int uct_mm_ep_has_tx_resources(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
+
+    if (uct_mm_ep_use_ring(ep)) {
+        return UCT_MM_EP_IS_ABLE_TO_SEND(ep->ring.head, ep->ring.cached_tail,
+                                         iface->config.ring_size);
+    }
+
     return UCT_MM_EP_IS_ABLE_TO_SEND(ep->fifo_ctl->head, ep->cached_tail,
                                      iface->config.fifo_size);
 }
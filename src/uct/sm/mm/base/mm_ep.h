@@ -30,6 +30,20 @@ typedef struct uct_mm_ep {
     uint64_t                   cached_tail; /* the sender's own copy of the remote FIFO's tail.
                                                it is not always updated with the actual remote tail value */
 
+    /* Sender ring in the remote FIFO segment, used instead of the FIFO once
+     * the receiver has activated it and consumed the ep's FIFO elements */
+    struct {
+        uct_mm_ring_ctl_t      *ctl;        /* ring control, NULL if the ep uses the FIFO */
+        void                   *elems;      /* ring elements */
+        volatile uint64_t      *active_word;/* word of the receiver's active-sender bitmap */
+        uint64_t               active_bit;  /* bit of this ring in active_word */
+        uint64_t               head;        /* where to write next */
+        uint64_t               cached_tail; /* sender's copy of the ring tail */
+        uint64_t               fifo_end;    /* FIFO head after the last element this
+                                               ep sent through the FIFO */
+        int                    ready;       /* the ep sends through the ring */
+    } ring;
+
     /* mapped remote memory chunks to which remote descriptors belong to.
      * (after attaching to them) */
     khash_t(uct_mm_remote_seg) remote_segs;
@@ -61,6 +61,32 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
      "Maximal number of receive completions to pick during RX poll",
      ucs_offsetof(uct_mm_iface_config_t, fifo_max_poll), UCS_CONFIG_TYPE_ULUNITS},
 
+    {"SENDER_RINGS", "0",
+     "Number of single-producer receive rings in the MM UCTs, in addition to the\n"
+     "shared receive FIFO. An endpoint takes a free ring when it is created and\n"
+     "sends only through it, so it does not contend with other senders on the\n"
+     "FIFO head. Endpoints which find no free ring use the shared FIFO.\n"
+     "Must be the same on all peers. 0 disables sender rings.",
+     ucs_offsetof(uct_mm_iface_config_t, ring_count), UCS_CONFIG_TYPE_UINT},
+
+    {"SENDER_RING_SIZE", "32",
+     "Number of elements in each sender ring in the MM UCTs (must be a power of\n"
+     "two and bigger than 1).",
+     ucs_offsetof(uct_mm_iface_config_t, ring_size), UCS_CONFIG_TYPE_UINT},
+
+    {"NUMA_POLICY", "preferred",
+     "NUMA policy of the receive FIFO and receive descriptors in the MM UCTs.\n"
+     "The memory is placed on the NUMA node of the CPU mask of the interface,\n"
+     "or of the CPU which creates the interface if the mask is not set. Since\n"
+     "senders copy the data directly to the receive descriptors, the whole\n"
+     "transfer path is then local to the receiver.\n"
+     " - default   : use the default policy of the process (usually, the pages\n"
+     "               are allocated on the node of the first process touching them).\n"
+     " - preferred : prefer the local node, fall back to other nodes.\n"
+     " - bind      : allocate only on the local node.",
+     ucs_offsetof(uct_mm_iface_config_t, numa_policy),
+     UCS_CONFIG_TYPE_ENUM(ucs_numa_policy_names)},
+
     {NULL}
 };
 
@@ -137,7 +163,7 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->cap.get.max_zcopy       = SIZE_MAX;
     iface_attr->cap.get.opt_zcopy_align = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.get.align_mtu       = iface_attr->cap.get.opt_zcopy_align;
-    iface_attr->cap.get.max_iov         = 1;
+    iface_attr->cap.get.max_iov         = UCT_SM_MAX_IOV;
 
     iface_attr->cap.am.max_short        = iface->config.fifo_elem_size -
                                           sizeof(uct_mm_fifo_element_t);
@@ -157,6 +183,7 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
                                           UCT_IFACE_FLAG_PUT_BCOPY           |
                                           UCT_IFACE_FLAG_ATOMIC_CPU          |
                                           UCT_IFACE_FLAG_GET_BCOPY           |
+                                          UCT_IFACE_FLAG_GET_ZCOPY           |
                                           UCT_IFACE_FLAG_AM_SHORT            |
                                           UCT_IFACE_FLAG_AM_BCOPY            |
                                           UCT_IFACE_FLAG_PENDING             |
@@ -184,15 +211,18 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->bandwidth.shared        = 0;
     iface_attr->overhead                = 10e-9; /* 10 ns */
     iface_attr->priority                = 0;
+    iface_attr->numa_node               = iface->numa_node;
 
     return UCS_OK;
 }
 
 static UCS_F_ALWAYS_INLINE void
-uct_mm_progress_fifo_tail(uct_mm_iface_t *iface)
+uct_mm_progress_fifo_tail(uct_mm_iface_t *iface, uint64_t prev_read_index)
 {
-    /* don't progress the tail every time - release in batches. improves performance */
-    if (iface->read_index & iface->fifo_release_factor_mask) {
+    /* don't progress the tail every time - release in batches, only when the
+     * read index crosses a release boundary. improves performance */
+    if ((prev_read_index | iface->fifo_release_factor_mask) >=
+        iface->read_index) {
         return;
     }
 
@@ -258,38 +288,236 @@ uct_mm_iface_process_recv(uct_mm_iface_t *iface,
 }
 
 static UCS_F_ALWAYS_INLINE int
-uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface)
+uct_mm_iface_elem_has_new_data(uint64_t index, uint8_t shift,
+                               uct_mm_fifo_element_t *elem)
 {
-    /* check the read_index to see if there is a new item to read
+    /* check the index to see if there is a new item to read
      * (checking the owner bit) */
-    return (((iface->read_index >> iface->fifo_shift) & 1) ==
-            (iface->read_index_elem->flags & 1));
+    return (((index >> shift) & 1) ==
+            (elem->flags & UCT_MM_FIFO_ELEM_FLAG_OWNER));
+}
+
+/* Receive a batch of up to max_count ready elements from the FIFO or a sender
+ * ring which has 2^shift elements, starting from read_index and its element
+ * first_elem. Returns the number of received elements and sets next_elem_p to
+ * the element which follows them. */
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_iface_poll_elems(uct_mm_iface_t *iface, void *elems, uint8_t shift,
+                        uint64_t read_index, uct_mm_fifo_element_t *first_elem,
+                        unsigned max_count, uct_mm_fifo_element_t **next_elem_p)
+{
+    uint64_t mask               = UCS_MASK(shift);
+    uct_mm_fifo_element_t *elem = first_elem;
+    unsigned count, i;
+
+    /* find how many elements are ready by their owner bits, rather than by
+     * reading the head, which is contended by the senders. meanwhile, start
+     * loading the payloads of bcopy elements so they are in cache by the time
+     * their handlers run */
+    for (count = 0; count < max_count; ++count) {
+        if (!uct_mm_iface_elem_has_new_data(read_index + count, shift, elem)) {
+            break;
+        }
+
+        if (!(elem->flags & UCT_MM_FIFO_ELEM_FLAG_INLINE)) {
+            ucs_prefetch(elem->desc_data);
+        }
+
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, elems,
+                                          (read_index + count + 1) & mask);
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    /* the element following the batch is likely the next one to be written */
+    ucs_prefetch(elem);
+
+    /* read the batch */
+    ucs_memory_cpu_load_fence();
+
+    elem = first_elem;
+    for (i = 0; i < count; ++i) {
+        uct_mm_iface_process_recv(iface, elem);
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, elems,
+                                          (read_index + i + 1) & mask);
+    }
+
+    *next_elem_p = elem;
+    return count;
 }
 
 static UCS_F_ALWAYS_INLINE unsigned
-uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
+uct_mm_iface_poll_fifo(uct_mm_iface_t *iface, unsigned max_count)
 {
-    if (!uct_mm_iface_fifo_has_new_data(iface)) {
+    uint64_t read_index = iface->read_index;
+    uct_mm_fifo_element_t *next_elem;
+    unsigned count;
+
+    count = uct_mm_iface_poll_elems(iface, iface->recv_fifo_elems,
+                                    iface->fifo_shift, read_index,
+                                    iface->read_index_elem, max_count,
+                                    &next_elem);
+    if (count == 0) {
+        return 0;
+    }
+
+    ucs_assert(read_index + count <= iface->recv_fifo_ctl->head);
+
+    /* raise the read_index once for the whole batch */
+    iface->read_index      = read_index + count;
+    iface->read_index_elem = next_elem;
+
+    uct_mm_progress_fifo_tail(iface, read_index);
+
+    return count;
+}
+
+static void uct_mm_iface_ring_free_descs(uct_mm_iface_t *iface,
+                                         uct_mm_iface_ring_t *ring,
+                                         unsigned num_elems)
+{
+    uct_mm_fifo_element_t *elem;
+    uct_mm_recv_desc_t *desc;
+    unsigned i;
+
+    for (i = 0; i < num_elems; i++) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ring->elems, i);
+        desc = (uct_mm_recv_desc_t*)UCS_PTR_BYTE_OFFSET(elem->desc_data,
+                                                        -iface->rx_headroom) - 1;
+        ucs_mpool_put(desc);
+    }
+}
+
+static void uct_mm_iface_ring_recycle(uct_mm_iface_t *iface,
+                                      uct_mm_iface_ring_t *ring)
+{
+    if (ring->active) {
+        uct_mm_iface_ring_free_descs(iface, ring, iface->config.ring_size);
+        ring->active = 0;
+    }
+
+    ucs_memory_cpu_store_fence();
+    ring->ctl->state = UCT_MM_RING_STATE_FREE;
+}
+
+/* Assign receive descriptors to the elements of a ring which was claimed by a
+ * sender, and let the sender use it */
+static ucs_status_t uct_mm_iface_ring_activate(uct_mm_iface_t *iface,
+                                               uct_mm_iface_ring_t *ring)
+{
+    uct_mm_fifo_element_t *elem;
+    ucs_status_t status;
+    unsigned i;
+
+    for (i = 0; i < iface->config.ring_size; i++) {
+        elem        = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ring->elems, i);
+        elem->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
+
+        status = uct_mm_assign_desc_to_fifo_elem(iface, elem, 1);
+        if (status != UCS_OK) {
+            uct_mm_iface_ring_free_descs(iface, ring, i);
+            return status;
+        }
+    }
+
+    ring->read_index = 0;
+    ring->active     = 1;
+    ring->ctl->tail  = 0;
+
+    /* the sender may have released the ring in the meantime */
+    if (ucs_atomic_cswap32(ucs_unaligned_ptr(&ring->ctl->state),
+                           UCT_MM_RING_STATE_CLAIMED,
+                           UCT_MM_RING_STATE_ACTIVE) !=
+        UCT_MM_RING_STATE_CLAIMED) {
+        uct_mm_iface_ring_recycle(iface, ring);
+    }
+
+    return UCS_OK;
+}
+
+/* Poll a ring whose bit in the active-sender bitmap was set, return the
+ * number of received elements. Sets the bit again if the ring has to be
+ * polled again. */
+static unsigned uct_mm_iface_poll_ring(uct_mm_iface_t *iface,
+                                       unsigned ring_index)
+{
+    uct_mm_iface_ring_t *ring = &iface->rings[ring_index];
+    uint64_t read_index       = ring->read_index;
+    unsigned count            = 0;
+    uct_mm_fifo_element_t *first_elem, *next_elem;
+    uint32_t state;
+
+    state = ring->ctl->state;
+    if (state == UCT_MM_RING_STATE_CLAIMED) {
+        if (uct_mm_iface_ring_activate(iface, ring) != UCS_OK) {
+            /* retry on the next progress */
+            goto out_resched;
+        }
+        return 0;
+    } else if ((state == UCT_MM_RING_STATE_FREE) ||
+               ((state == UCT_MM_RING_STATE_RELEASED) && !ring->active)) {
+        if (state == UCT_MM_RING_STATE_RELEASED) {
+            uct_mm_iface_ring_recycle(iface, ring);
+        }
         return 0;
     }
 
-    /* read from read_index_elem */
+    /* the state is read before the elements, so if the sender has released
+     * the ring, all of its elements are visible */
     ucs_memory_cpu_load_fence();
-    ucs_assert(iface->read_index <= iface->recv_fifo_ctl->head);
 
-    uct_mm_iface_process_recv(iface, iface->read_index_elem);
+    first_elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ring->elems,
+                                            read_index &
+                                            UCS_MASK(iface->ring_shift));
+    count      = uct_mm_iface_poll_elems(iface, ring->elems, iface->ring_shift,
+                                         read_index, first_elem,
+                                         iface->config.fifo_max_poll,
+                                         &next_elem);
+    if (count > 0) {
+        ring->read_index = read_index + count;
+        ring->ctl->tail  = ring->read_index;
+        if (count == iface->config.fifo_max_poll) {
+            /* the ring may have more elements */
+            goto out_resched;
+        }
+    }
 
-    /* raise the read_index */
-    iface->read_index++;
+    if (state == UCT_MM_RING_STATE_RELEASED) {
+        uct_mm_iface_ring_recycle(iface, ring);
+    }
 
-    /* the next fifo_element which the read_index points to */
-    iface->read_index_elem =
-        UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems,
-                                   (iface->read_index & iface->fifo_mask));
+    return count;
 
-    uct_mm_progress_fifo_tail(iface);
+out_resched:
+    ucs_atomic_or64(&iface->ring_active[ring_index / 64],
+                    UCS_BIT(ring_index % 64));
+    return count;
+}
 
-    return 1;
+static UCS_F_NOINLINE unsigned uct_mm_iface_poll_rings(uct_mm_iface_t *iface)
+{
+    unsigned total_count = 0;
+    unsigned word, bit;
+    uint64_t active;
+
+    for (word = 0; word < ucs_div_round_up(iface->config.ring_count, 64);
+         ++word) {
+        active = iface->ring_active[word];
+        if (active == 0) {
+            continue;
+        }
+
+        /* clear the bits before polling the rings, so a sender which adds
+         * an element after the ring was polled sets its bit again */
+        ucs_atomic_and64(&iface->ring_active[word], ~active);
+        ucs_for_each_bit(bit, active) {
+            total_count += uct_mm_iface_poll_ring(iface, (word * 64) + bit);
+        }
+    }
+
+    return total_count;
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -323,21 +551,19 @@ uct_mm_iface_fifo_window_adjust(uct_mm_iface_t *iface,
 static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
 {
     uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
-    unsigned total_count  = 0;
-    unsigned count;
+    unsigned total_count;
 
     ucs_assert(iface->fifo_poll_count >= UCT_MM_IFACE_FIFO_MIN_POLL);
 
-    /* progress receive */
-    do {
-        count = uct_mm_iface_poll_fifo(iface);
-        ucs_assert(count < 2);
-        total_count += count;
-        ucs_assert(total_count < UINT_MAX);
-    } while ((count != 0) && (total_count < iface->fifo_poll_count));
+    /* progress receive, in a single batch of up to the FIFO window size */
+    total_count = uct_mm_iface_poll_fifo(iface, iface->fifo_poll_count);
 
     uct_mm_iface_fifo_window_adjust(iface, total_count);
 
+    if (iface->config.ring_count > 0) {
+        total_count += uct_mm_iface_poll_rings(iface);
+    }
+
     /* progress the pending sends (if there are any) */
     ucs_arbiter_dispatch(&iface->arbiter, 1, uct_mm_ep_process_pending,
                          &total_count);
@@ -382,6 +608,7 @@ static uct_iface_ops_t uct_mm_iface_ops = {
     .ep_put_short             = uct_sm_ep_put_short,
     .ep_put_bcopy             = uct_sm_ep_put_bcopy,
     .ep_get_bcopy             = uct_sm_ep_get_bcopy,
+    .ep_get_zcopy             = uct_sm_ep_get_zcopy,
     .ep_am_short              = uct_mm_ep_am_short,
     .ep_am_bcopy              = uct_mm_ep_am_bcopy,
     .ep_atomic_cswap64        = uct_sm_ep_atomic_cswap64,
@@ -410,6 +637,40 @@ static uct_iface_ops_t uct_mm_iface_ops = {
     .iface_is_reachable       = uct_mm_iface_is_reachable
 };
 
+static int uct_mm_iface_numa_node(const uct_iface_params_t *params)
+{
+    int cpu;
+
+    if (params->field_mask & UCT_IFACE_PARAM_FIELD_CPU_MASK) {
+        cpu = ucs_cpu_set_find_lcs(&params->cpu_mask);
+        if (ucs_cpu_is_set(cpu, &params->cpu_mask)) {
+            return ucs_numa_node_of_cpu(cpu);
+        }
+    }
+
+    /* the interface is usually progressed by the thread which creates it */
+    return ucs_numa_current_node();
+}
+
+static void uct_mm_iface_numa_bind(uct_mm_iface_t *iface, void *address,
+                                   size_t length, const char *name)
+{
+    ucs_status_t status;
+
+    if (iface->numa_node < 0) {
+        return;
+    }
+
+    status = ucs_numa_mem_bind(address, length, iface->config.numa_policy,
+                               iface->numa_node);
+    if (status != UCS_OK) {
+        ucs_diag("mm_iface %p: failed to place %s %p..%p on numa node %d, "
+                 "using default memory policy", iface, name, address,
+                 UCS_PTR_BYTE_OFFSET(address, length), iface->numa_node);
+        iface->numa_node = -1;
+    }
+}
+
 static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
                                         uct_mem_h memh)
 {
@@ -426,6 +687,13 @@ static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
         return;
     }
 
+    if (seg != iface->numa_last_seg) {
+        /* first descriptor of a new chunk - move the chunk to the FIFO node
+         * before the senders fault in its payload pages */
+        uct_mm_iface_numa_bind(iface, seg->address, seg->length, "descriptors");
+        iface->numa_last_seg = seg;
+    }
+
     offset = UCS_PTR_BYTE_DIFF(seg->address, desc + 1) + iface->rx_headroom;
     ucs_assert(offset <= UINT_MAX);
 
@@ -472,6 +740,73 @@ void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
     *fifo_elems_p = UCS_PTR_BYTE_OFFSET(fifo_ctl, UCT_MM_FIFO_CTL_SIZE);
 }
 
+uct_mm_ring_ctl_t *uct_mm_iface_get_rings_ptrs(uct_mm_iface_t *iface,
+                                               void *fifo_elems,
+                                               volatile uint64_t **ring_active_p)
+{
+    void *rings_mem;
+
+    rings_mem = (void*)ucs_align_up_pow2(
+            (uintptr_t)UCT_MM_IFACE_GET_FIFO_ELEM(iface, fifo_elems,
+                                                  iface->config.fifo_size),
+            UCS_SYS_CACHE_LINE_SIZE);
+
+    *ring_active_p = rings_mem;
+    return UCS_PTR_BYTE_OFFSET(rings_mem,
+                               UCT_MM_RINGS_BITMAP_SIZE(iface->config.ring_count));
+}
+
+static ucs_status_t uct_mm_iface_rings_init(uct_mm_iface_t *iface)
+{
+    uct_mm_ring_ctl_t *first_ring;
+    unsigned i;
+
+    if (iface->config.ring_count == 0) {
+        iface->ring_active = NULL;
+        iface->rings       = NULL;
+        return UCS_OK;
+    }
+
+    iface->rings = ucs_calloc(iface->config.ring_count, sizeof(*iface->rings),
+                              "mm_rings");
+    if (iface->rings == NULL) {
+        ucs_error("failed to allocate %u mm sender rings",
+                  iface->config.ring_count);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    first_ring = uct_mm_iface_get_rings_ptrs(iface, iface->recv_fifo_elems,
+                                             &iface->ring_active);
+    memset((void*)iface->ring_active, 0,
+           UCT_MM_RINGS_BITMAP_SIZE(iface->config.ring_count));
+
+    for (i = 0; i < iface->config.ring_count; i++) {
+        iface->rings[i].ctl        = uct_mm_iface_get_ring_ctl(iface, first_ring,
+                                                               i);
+        iface->rings[i].elems      = iface->rings[i].ctl + 1;
+        iface->rings[i].read_index = 0;
+        iface->rings[i].active     = 0;
+        iface->rings[i].ctl->state = UCT_MM_RING_STATE_FREE;
+        iface->rings[i].ctl->tail  = 0;
+    }
+
+    return UCS_OK;
+}
+
+static void uct_mm_iface_rings_cleanup(uct_mm_iface_t *iface)
+{
+    unsigned i;
+
+    for (i = 0; i < iface->config.ring_count; i++) {
+        if (iface->rings[i].active) {
+            uct_mm_iface_ring_free_descs(iface, &iface->rings[i],
+                                         iface->config.ring_size);
+        }
+    }
+
+    ucs_free(iface->rings);
+}
+
 static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
 {
     ucs_status_t status;
@@ -531,9 +866,10 @@ static void uct_mm_iface_log_created(uct_mm_iface_t *iface)
     uct_mm_seg_t UCS_V_UNUSED *seg = iface->recv_fifo_mem.memh;
 
     ucs_debug("created mm iface %p FIFO id 0x%"PRIx64
-              " va %p size %zu (%u x %u elems)",
+              " va %p size %zu (%u x %u elems) numa node %d",
               iface, seg->seg_id, seg->address, seg->length,
-              iface->config.fifo_elem_size, iface->config.fifo_size);
+              iface->config.fifo_elem_size, iface->config.fifo_size,
+              iface->numa_node);
 }
 
 static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
@@ -561,6 +897,16 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
+    if ((mm_config->ring_count > UCT_MM_IFACE_MAX_RINGS) ||
+        ((mm_config->ring_count > 0) &&
+         ((mm_config->ring_size <= 1) || !ucs_is_pow2(mm_config->ring_size)))) {
+        ucs_error("The MM sender rings number must not exceed %d, and their "
+                  "size must be a power of two and bigger than 1.",
+                  UCT_MM_IFACE_MAX_RINGS);
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     /* check the value defining the FIFO batch release */
     if ((mm_config->release_fifo_factor < 0) || (mm_config->release_fifo_factor >= 1)) {
         ucs_error("The MM release FIFO factor must be: (0 =< factor < 1).");
@@ -580,6 +926,9 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     self->config.fifo_size         = mm_config->fifo_size;
     self->config.fifo_elem_size    = mm_config->fifo_elem_size;
     self->config.seg_size          = mm_config->seg_size;
+    self->config.ring_count        = mm_config->ring_count;
+    self->config.ring_size         = mm_config->ring_size;
+    self->config.numa_policy       = mm_config->numa_policy;
     self->config.fifo_max_poll     = ((mm_config->fifo_max_poll == UCS_ULUNITS_AUTO) ?
                                       UCT_MM_IFACE_FIFO_MAX_POLL :
                                       /* trim by the maximum unsigned integer value */
@@ -592,10 +941,15 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                                      1)));
     self->fifo_mask                = self->config.fifo_size - 1;
     self->fifo_shift               = ucs_count_trailing_zero_bits(mm_config->fifo_size);
+    self->ring_shift               = ucs_count_trailing_zero_bits(mm_config->ring_size);
     self->rx_headroom              = (params->field_mask &
                                       UCT_IFACE_PARAM_FIELD_RX_HEADROOM) ?
                                      params->rx_headroom : 0;
     self->release_desc.cb          = uct_mm_iface_release_desc;
+    self->numa_node                = (self->config.numa_policy ==
+                                      UCS_NUMA_POLICY_DEFAULT) ? -1 :
+                                     uct_mm_iface_numa_node(params);
+    self->numa_last_seg            = NULL;
 
     /* Allocate the receive FIFO */
     status = uct_iface_mem_alloc(&self->super.super.super,
@@ -607,6 +961,9 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         return status;
     }
 
+    uct_mm_iface_numa_bind(self, self->recv_fifo_mem.address,
+                           self->recv_fifo_mem.length, "receive FIFO");
+
     uct_mm_iface_set_fifo_ptrs(self->recv_fifo_mem.address,
                                &self->recv_fifo_ctl, &self->recv_fifo_elems);
     self->recv_fifo_ctl->head = 0;
@@ -660,6 +1017,11 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         }
     }
 
+    status = uct_mm_iface_rings_init(self);
+    if (status != UCS_OK) {
+        goto destroy_descs;
+    }
+
     ucs_arbiter_init(&self->arbiter);
     uct_mm_iface_log_created(self);
 
@@ -686,6 +1048,7 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
     /* return all the descriptors that are now 'assigned' to the FIFO,
      * to their mpool */
     uct_mm_iface_free_rx_descs(self, self->config.fifo_size);
+    uct_mm_iface_rings_cleanup(self);
 
     ucs_mpool_put(self->last_recv_desc);
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
@@ -15,6 +15,7 @@
 #include <ucs/arch/cpu.h>
 #include <ucs/debug/memtrack.h>
 #include <ucs/datastruct/arbiter.h>
+#include <ucs/memory/numa.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/sys.h>
 #include <sys/shm.h>
@@ -34,9 +35,30 @@ enum {
 #define UCT_MM_GET_FIFO_SIZE(_iface) \
     (UCT_MM_FIFO_CTL_SIZE + \
      ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size) + \
+     UCT_MM_GET_RINGS_SIZE(_iface) + \
       (UCS_SYS_CACHE_LINE_SIZE - 1))
 
 
+/* Sender rings follow the FIFO elements, starting from a cache line: an
+ * active-sender bitmap, then every ring's control structure and elements */
+#define UCT_MM_GET_RINGS_SIZE(_iface) \
+    (((_iface)->config.ring_count == 0) ? 0 : \
+     ((UCS_SYS_CACHE_LINE_SIZE - 1) + \
+      UCT_MM_RINGS_BITMAP_SIZE((_iface)->config.ring_count) + \
+      ((_iface)->config.ring_count * UCT_MM_GET_RING_SIZE(_iface))))
+
+
+#define UCT_MM_RINGS_BITMAP_SIZE(_ring_count) \
+    ucs_align_up(ucs_div_round_up(_ring_count, 64) * sizeof(uint64_t), \
+                 UCS_SYS_CACHE_LINE_SIZE)
+
+
+#define UCT_MM_GET_RING_SIZE(_iface) \
+    (sizeof(uct_mm_ring_ctl_t) + \
+     ucs_align_up((_iface)->config.ring_size * (_iface)->config.fifo_elem_size, \
+                  UCS_SYS_CACHE_LINE_SIZE))
+
+
 #define UCT_MM_IFACE_GET_FIFO_ELEM(_iface, _fifo, _index) \
     ((uct_mm_fifo_element_t*) \
      UCS_PTR_BYTE_OFFSET(_fifo, (_index) * (_iface)->config.fifo_elem_size))
@@ -66,6 +88,21 @@ enum {
 #define UCT_MM_IFACE_FIFO_AI_VALUE              1 /* FIFO window += AI value */
 #define UCT_MM_IFACE_FIFO_MD_FACTOR             2 /* FIFO window /= MD factor */
 
+#define UCT_MM_IFACE_MAX_RINGS               1024 /* Maximal number of sender rings */
+
+
+/**
+ * State of a sender ring, see @ref uct_mm_ring_ctl_t
+ */
+enum {
+    UCT_MM_RING_STATE_FREE,      /* Not used by any sender */
+    UCT_MM_RING_STATE_CLAIMED,   /* Taken by a sender, waiting for the receiver
+                                    to assign receive descriptors */
+    UCT_MM_RING_STATE_ACTIVE,    /* Sender may write to the ring */
+    UCT_MM_RING_STATE_RELEASED   /* Sender is gone, the receiver recycles the
+                                    ring after draining it */
+};
+
 
 /**
  * MM interface configuration
@@ -81,6 +118,10 @@ typedef struct uct_mm_iface_config {
     ucs_ternary_value_t      hugetlb_mode;        /* Enable using huge pages for
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
+    unsigned                 ring_count;          /* Number of sender rings */
+    unsigned                 ring_size;           /* Size of each sender ring */
+    ucs_numa_policy_t        numa_policy;         /* Placement of the receive
+                                                   * FIFO and descriptors */
     uct_iface_mpool_config_t mp;
 } uct_mm_iface_config_t;
 
@@ -111,6 +152,21 @@ typedef struct uct_mm_fifo_ctl {
 } UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_fifo_ctl_t;
 
 
+/**
+ * MM sender ring control segment. A sender ring is a single-producer FIFO
+ * which is owned by one endpoint, so the producer keeps the head privately.
+ */
+typedef struct uct_mm_ring_ctl {
+    /* 1st cacheline */
+    volatile uint32_t         state;          /* UCT_MM_RING_STATE_xx */
+    UCS_CACHELINE_PADDING(uint32_t);
+
+    /* 2nd cacheline */
+    volatile uint64_t         tail;           /* How much was consumed */
+    UCS_CACHELINE_PADDING(uint64_t);
+} UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_ring_ctl_t;
+
+
 /**
  * MM receive descriptor info in the shared FIFO
  */
@@ -154,6 +210,17 @@ typedef struct uct_mm_recv_desc {
 } uct_mm_recv_desc_t;
 
 
+/**
+ * Receiver side of a sender ring
+ */
+typedef struct uct_mm_iface_ring {
+    uct_mm_ring_ctl_t       *ctl;             /* ring control in the FIFO segment */
+    void                    *elems;           /* ring elements */
+    uint64_t                read_index;       /* actual reading location */
+    int                     active;           /* receive descriptors are assigned */
+} uct_mm_iface_ring_t;
+
+
 /**
  * MM trandport interface
  */
@@ -186,6 +253,16 @@ typedef struct uct_mm_iface {
     ucs_mpool_t             recv_desc_mp;
     uct_mm_recv_desc_t      *last_recv_desc;  /* next receive descriptor to use */
 
+    volatile uint64_t       *ring_active;     /* bitmap of rings with new data,
+                                                 or with a changed state */
+    uct_mm_iface_ring_t     *rings;           /* sender rings */
+    uint8_t                 ring_shift;       /* = log2(ring_size) */
+
+    int                     numa_node;        /* NUMA node of the receive FIFO and
+                                                 descriptors, or -1 if not bound */
+    uct_mm_seg_t            *numa_last_seg;   /* last descriptors segment which
+                                                 was bound to numa_node */
+
     int                     signal_fd;        /* Unix socket for receiving remote signal */
 
     size_t                  rx_headroom;
@@ -197,6 +274,9 @@ typedef struct uct_mm_iface {
         unsigned            fifo_elem_size;
         unsigned            seg_size;         /* size of the receive descriptor (for payload)*/
         unsigned            fifo_max_poll;
+        unsigned            ring_count;       /* number of sender rings */
+        unsigned            ring_size;        /* number of elements in a sender ring */
+        ucs_numa_policy_t   numa_policy;
     } config;
 } uct_mm_iface_t;
 
@@ -259,6 +339,29 @@ void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p);
 
 
+/**
+ * Get the pointers to the sender rings area which follows the FIFO elements.
+ * @param [in] iface          Interface, which defines the FIFO and rings sizes.
+ * @param [in] fifo_elems     Pointer to the array of FIFO elements.
+ * @param [out] ring_active_p Pointer to the active-sender bitmap.
+ *
+ * @return Pointer to the first ring control structure.
+ */
+uct_mm_ring_ctl_t *uct_mm_iface_get_rings_ptrs(uct_mm_iface_t *iface,
+                                               void *fifo_elems,
+                                               volatile uint64_t **ring_active_p);
+
+
+static UCS_F_ALWAYS_INLINE uct_mm_ring_ctl_t*
+uct_mm_iface_get_ring_ctl(uct_mm_iface_t *iface, uct_mm_ring_ctl_t *first_ring,
+                          unsigned ring_index)
+{
+    return (uct_mm_ring_ctl_t*)UCS_PTR_BYTE_OFFSET(first_ring,
+                                                   ring_index *
+                                                   UCT_MM_GET_RING_SIZE(iface));
+}
+
+
 UCS_CLASS_DECLARE_NEW_FUNC(uct_mm_iface_t, uct_iface_t, uct_md_h, uct_worker_h,
                            const uct_iface_params_t*, const uct_iface_config_t*);
 
@@ -11,11 +11,15 @@
 
 #include <uct/sm/mm/base/mm_md.h>
 #include <uct/sm/mm/base/mm_iface.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/list.h>
 #include <ucs/debug/memtrack.h>
 #include <ucs/debug/log.h>
 #include <ucs/sys/string.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <ucs/sys/sys.h>
+#include <pthread.h>
 
 
 /* File open flags */
@@ -45,12 +49,17 @@
 #define UCT_POSIX_SHM_OPEN_DIR          "/dev/shm"       /* directory path for shm_open() */
 #define UCT_POSIX_FILE_FMT              "/ucx_shm_posix_%"PRIx64
 #define UCT_POSIX_PROCFS_FILE_FMT       "/proc/%d/fd/%d" /* file pattern for procfs mode */
+#define UCT_POSIX_MEMFD_NAME            "ucx_shm_posix"  /* name of memfd backing files */
+
+/* Maximal number of unused remote segments which are kept mapped */
+#define UCT_POSIX_RSEG_CACHE_MAX_IDLE   32
 
 
 typedef struct uct_posix_md_config {
     uct_mm_md_config_t        super;
     char                      *dir;
     int                       use_proc_link;
+    int                       use_memfd;
 } uct_posix_md_config_t;
 
 typedef struct uct_posix_packed_rkey {
@@ -59,6 +68,27 @@ typedef struct uct_posix_packed_rkey {
     size_t                    length;
 } UCS_S_PACKED uct_posix_packed_rkey_t;
 
+/* Remote segment attached by rkey_unpack(). Segments are cached by their id,
+ * so repeated transfers from the same remote buffer map it only once. */
+typedef struct uct_posix_rseg {
+    uct_mm_remote_seg_t       super;
+    uct_mm_seg_id_t           seg_id;
+    dev_t                     dev;        /* identity of the backing file, to */
+    ino_t                     ino;        /* detect a reused segment id */
+    unsigned                  refcount;
+    int                       cached;     /* whether the segment is in the hash */
+    ucs_list_link_t           list;       /* entry in the idle list */
+} uct_posix_rseg_t;
+
+
+KHASH_MAP_INIT_INT64(uct_posix_rseg, uct_posix_rseg_t*);
+
+
+static pthread_mutex_t uct_posix_rseg_lock = PTHREAD_MUTEX_INITIALIZER;
+static khash_t(uct_posix_rseg) uct_posix_rseg_hash;
+static UCS_LIST_HEAD(uct_posix_rseg_idle); /* unused segments, oldest first */
+static unsigned uct_posix_rseg_num_idle = 0;
+
 
 static ucs_config_field_t uct_posix_md_config_table[] = {
   {"MM_", "", NULL,
@@ -74,6 +104,14 @@ static ucs_config_field_t uct_posix_md_config_table[] = {
    " n   - Use original file path to share posix file.\n",
    ucs_offsetof(uct_posix_md_config_t, use_proc_link), UCS_CONFIG_TYPE_BOOL},
 
+  {"USE_MEMFD", "y",
+   "Use memfd_create() to create the backing file when it is shared by a\n"
+   "/proc/<pid>/fd/<fd> link and located in " UCT_POSIX_SHM_OPEN_DIR ". The file\n"
+   "has no name in the file system, so it never has to be unlinked and it works\n"
+   "in containers where " UCT_POSIX_SHM_OPEN_DIR " is not shared or is too small.\n"
+   "If memfd_create() fails, shm_open() is used.",
+   ucs_offsetof(uct_posix_md_config_t, use_memfd), UCS_CONFIG_TYPE_BOOL},
+
   {NULL}
 };
 
@@ -129,6 +167,13 @@ static void uct_posix_mmid_procfs_unpack(uint64_t mmid, int *pid_p, int *fd_p)
     *pid_p = mmid & UCS_MASK(UCT_POSIX_PROCFS_MMID_PID_BITS);
 }
 
+static uct_mm_seg_id_t uct_posix_procfs_seg_id(int fd)
+{
+    return uct_posix_mmid_procfs_pack(fd) | UCT_POSIX_SEG_FLAG_PROCFS |
+           (ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID) ? 0 :
+            UCT_POSIX_SEG_FLAG_PID_NS);
+}
+
 static ucs_status_t uct_posix_test_mem(int shm_fd, size_t length)
 {
     const size_t chunk_size = 64 * UCS_KBYTE;
@@ -385,6 +430,20 @@ uct_posix_segment_open(uct_mm_md_t *md, uct_mm_seg_id_t *seg_id_p, int *fd_p)
     ucs_status_t status;
     unsigned rand_seed;
 
+#if HAVE_DECL_MEMFD_CREATE
+    if (posix_config->use_memfd && posix_config->use_proc_link &&
+        uct_posix_use_shm_open(posix_config)) {
+        *fd_p = memfd_create(UCT_POSIX_MEMFD_NAME, MFD_CLOEXEC);
+        if (*fd_p >= 0) {
+            *seg_id_p = uct_posix_procfs_seg_id(*fd_p);
+            return UCS_OK;
+        }
+
+        ucs_debug("memfd_create(%s) failed: %m, using shm_open()",
+                  UCT_POSIX_MEMFD_NAME);
+    }
+#endif
+
     /* Generate random 32-bit shared memory id and make sure it's not used
      * already by opening the file with O_CREAT|O_EXCL */
     rand_seed = ucs_generate_uuid((uintptr_t)md);
@@ -441,19 +500,17 @@ uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
     }
 
     /* If using procfs link instead of mmid, remove the original file and update
-     * seg->seg_id */
-    if (posix_config->use_proc_link) {
+     * seg->seg_id. A memfd file is already identified by procfs link. */
+    if (posix_config->use_proc_link &&
+        !(seg->seg_id & UCT_POSIX_SEG_FLAG_PROCFS)) {
         status = uct_posix_unlink(md, seg->seg_id);
         if (status != UCS_OK) {
             goto err_close;
         }
 
         /* Replace mmid by pid+fd. Keep previous SHM_OPEN flag for mkey_pack() */
-        seg->seg_id = uct_posix_mmid_procfs_pack(fd) |
-                      (seg->seg_id & UCT_POSIX_SEG_FLAG_SHM_OPEN) |
-                      UCT_POSIX_SEG_FLAG_PROCFS |
-                      (ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID) ? 0 :
-                       UCT_POSIX_SEG_FLAG_PID_NS);
+        seg->seg_id = uct_posix_procfs_seg_id(fd) |
+                      (seg->seg_id & UCT_POSIX_SEG_FLAG_SHM_OPEN);
     }
 
     /* mmap the shared memory segment that was created by shm_open */
@@ -608,12 +665,91 @@ static void uct_posix_mem_detach(uct_mm_md_t *md, const uct_mm_remote_seg_t *rse
 }
 
 static ucs_status_t
-uct_posix_rkey_unpack(uct_component_t *component, const void *rkey_buffer,
-                      uct_rkey_t *rkey_p, void **handle_p)
+uct_posix_seg_stat(uct_mm_seg_id_t seg_id, const char *dir, struct stat *st)
 {
-    const uct_posix_packed_rkey_t *packed_rkey = rkey_buffer;
-    uct_mm_remote_seg_t *rseg;
+    uint64_t mmid = seg_id & UCT_POSIX_SEG_MMID_MASK;
+    char file_path[PATH_MAX];
+    int pid, peer_fd;
+
+    if (seg_id & UCT_POSIX_SEG_FLAG_PROCFS) {
+        uct_posix_mmid_procfs_unpack(mmid, &pid, &peer_fd);
+        ucs_snprintf_safe(file_path, sizeof(file_path),
+                          UCT_POSIX_PROCFS_FILE_FMT, pid, peer_fd);
+    } else if (seg_id & UCT_POSIX_SEG_FLAG_SHM_OPEN) {
+        ucs_snprintf_safe(file_path, sizeof(file_path),
+                          UCT_POSIX_SHM_OPEN_DIR UCT_POSIX_FILE_FMT, mmid);
+    } else {
+        ucs_snprintf_safe(file_path, sizeof(file_path), "%s" UCT_POSIX_FILE_FMT,
+                          dir, mmid);
+    }
+
+    if (stat(file_path, st) < 0) {
+        ucs_error("stat(%s) failed: %m", file_path);
+        return UCS_ERR_SHMEM_SEGMENT;
+    }
+
+    return UCS_OK;
+}
+
+static void uct_posix_rseg_destroy(uct_posix_rseg_t *rseg)
+{
+    uct_posix_mem_detach_common(&rseg->super);
+    ucs_free(rseg);
+}
+
+/* Remove an unused segment from the cache and unmap it */
+static void uct_posix_rseg_evict(uct_posix_rseg_t *rseg)
+{
+    khiter_t iter;
+
+    ucs_assert(rseg->cached && (rseg->refcount == 0));
+
+    iter = kh_get(uct_posix_rseg, &uct_posix_rseg_hash, rseg->seg_id);
+    ucs_assert(iter != kh_end(&uct_posix_rseg_hash));
+    kh_del(uct_posix_rseg, &uct_posix_rseg_hash, iter);
+
+    ucs_list_del(&rseg->list);
+    --uct_posix_rseg_num_idle;
+    uct_posix_rseg_destroy(rseg);
+}
+
+static ucs_status_t
+uct_posix_rseg_get(const uct_posix_packed_rkey_t *packed_rkey,
+                   uct_posix_rseg_t **rseg_p)
+{
+    const char *dir = (const char*)(packed_rkey + 1);
+    uct_posix_rseg_t *rseg;
     ucs_status_t status;
+    struct stat st;
+    khiter_t iter;
+    int ret;
+
+    status = uct_posix_seg_stat(packed_rkey->seg_id, dir, &st);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    iter = kh_get(uct_posix_rseg, &uct_posix_rseg_hash, packed_rkey->seg_id);
+    if (iter != kh_end(&uct_posix_rseg_hash)) {
+        rseg = kh_val(&uct_posix_rseg_hash, iter);
+        if ((rseg->dev == st.st_dev) && (rseg->ino == st.st_ino) &&
+            ((size_t)rseg->super.cookie >= packed_rkey->length)) {
+            if (rseg->refcount++ == 0) {
+                ucs_list_del(&rseg->list);
+                --uct_posix_rseg_num_idle;
+            }
+            *rseg_p = rseg;
+            return UCS_OK;
+        }
+
+        /* the remote segment was released, and its id was reused by a new one */
+        if (rseg->refcount == 0) {
+            uct_posix_rseg_evict(rseg);
+        } else {
+            kh_del(uct_posix_rseg, &uct_posix_rseg_hash, iter);
+            rseg->cached = 0;
+        }
+    }
 
     rseg = ucs_malloc(sizeof(*rseg), "posix_remote_seg");
     if (rseg == NULL) {
@@ -622,30 +758,78 @@ uct_posix_rkey_unpack(uct_component_t *component, const void *rkey_buffer,
     }
 
     status = uct_posix_mem_attach_common(packed_rkey->seg_id,
-                                         packed_rkey->length,
-                                         (const char*)(packed_rkey + 1), rseg);
+                                         packed_rkey->length, dir,
+                                         &rseg->super);
     if (status != UCS_OK) {
         ucs_free(rseg);
         return status;
     }
 
-    uct_mm_md_make_rkey(rseg->address, packed_rkey->address, rkey_p);
-    *handle_p = rseg;
+    rseg->seg_id   = packed_rkey->seg_id;
+    rseg->dev      = st.st_dev;
+    rseg->ino      = st.st_ino;
+    rseg->refcount = 1;
+    rseg->cached   = 1;
+
+    iter = kh_put(uct_posix_rseg, &uct_posix_rseg_hash, rseg->seg_id, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        /* keep the mapping private to this rkey */
+        rseg->cached = 0;
+    } else {
+        ucs_assert(ret != UCS_KH_PUT_KEY_PRESENT);
+        kh_val(&uct_posix_rseg_hash, iter) = rseg;
+    }
+
+    *rseg_p = rseg;
     return UCS_OK;
 }
 
+static void uct_posix_rseg_put(uct_posix_rseg_t *rseg)
+{
+    ucs_assert(rseg->refcount > 0);
+    if (--rseg->refcount > 0) {
+        return;
+    }
+
+    if (!rseg->cached) {
+        uct_posix_rseg_destroy(rseg);
+        return;
+    }
+
+    /* keep the segment mapped for the next rkey of the same remote memory */
+    ucs_list_add_tail(&uct_posix_rseg_idle, &rseg->list);
+    if (++uct_posix_rseg_num_idle > UCT_POSIX_RSEG_CACHE_MAX_IDLE) {
+        uct_posix_rseg_evict(ucs_list_head(&uct_posix_rseg_idle,
+                                           uct_posix_rseg_t, list));
+    }
+}
+
 static ucs_status_t
-uct_posix_rkey_release(uct_component_t *component, uct_rkey_t rkey, void *handle)
+uct_posix_rkey_unpack(uct_component_t *component, const void *rkey_buffer,
+                      uct_rkey_t *rkey_p, void **handle_p)
 {
-    uct_mm_remote_seg_t *rseg = handle;
+    const uct_posix_packed_rkey_t *packed_rkey = rkey_buffer;
+    uct_posix_rseg_t *rseg;
     ucs_status_t status;
 
-    status = uct_posix_mem_detach_common(rseg);
+    pthread_mutex_lock(&uct_posix_rseg_lock);
+    status = uct_posix_rseg_get(packed_rkey, &rseg);
+    pthread_mutex_unlock(&uct_posix_rseg_lock);
     if (status != UCS_OK) {
         return status;
     }
 
-    ucs_free(rseg);
+    uct_mm_md_make_rkey(rseg->super.address, packed_rkey->address, rkey_p);
+    *handle_p = rseg;
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_posix_rkey_release(uct_component_t *component, uct_rkey_t rkey, void *handle)
+{
+    pthread_mutex_lock(&uct_posix_rseg_lock);
+    uct_posix_rseg_put(handle);
+    pthread_mutex_unlock(&uct_posix_rseg_lock);
     return UCS_OK;
 }
 
@@ -673,3 +857,17 @@ static uct_mm_md_mapper_ops_t uct_posix_md_ops = {
 
 UCT_MM_TL_DEFINE(posix, &uct_posix_md_ops, uct_posix_rkey_unpack,
                  uct_posix_rkey_release, "POSIX_")
+
+UCS_STATIC_CLEANUP {
+    uct_posix_rseg_t *rseg, *tmp;
+
+    ucs_list_for_each_safe(rseg, tmp, &uct_posix_rseg_idle, list) {
+        uct_posix_rseg_evict(rseg);
+    }
+
+    if (kh_size(&uct_posix_rseg_hash) != 0) {
+        ucs_debug("%u posix remote segments are still in use",
+                  kh_size(&uct_posix_rseg_hash));
+    }
+    kh_destroy_inplace(uct_posix_rseg, &uct_posix_rseg_hash);
+}
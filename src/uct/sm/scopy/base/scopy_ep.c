@@ -11,6 +11,7 @@
 #include "scopy_ep.h"
 
 #include <uct/base/uct_iov.inl>
+#include <ucs/arch/atomic.h>
 
 
 const char* uct_scopy_tx_op_str[] = {
@@ -31,6 +32,14 @@ UCS_CLASS_INIT_FUNC(uct_scopy_ep_t, const uct_ep_params_t *params)
 
 static UCS_CLASS_CLEANUP_FUNC(uct_scopy_ep_t)
 {
+    uct_scopy_iface_t *iface = ucs_derived_of(self->super.super.iface,
+                                              uct_scopy_iface_t);
+
+    if ((iface->helpers.tx != NULL) &&
+        (iface->helpers.tx->split.ep == &self->super.super)) {
+        uct_scopy_iface_helpers_release(iface);
+    }
+
     ucs_arbiter_group_cleanup(&self->arb_group);
 }
 
@@ -67,9 +76,11 @@ uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
     }
 
     uct_scopy_ep_tx_init_common(tx, tx_op, comp);
-    tx->rkey        = rkey;
-    tx->remote_addr = remote_addr;
-    tx->iov_cnt     = 0;
+    tx->rkey         = rkey;
+    tx->remote_addr  = remote_addr;
+    tx->iov_cnt      = 0;
+    tx->split.ep     = tl_ep;
+    tx->split.length = 0;
     ucs_iov_iter_init(&tx->iov_iter);
     for (iov_it = 0; iov_it < iov_cnt; iov_it++) {
         if (uct_iov_get_length(&iov[iov_it]) == 0) {
@@ -125,6 +136,67 @@ ucs_status_t uct_scopy_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
                                 rkey, comp, UCT_SCOPY_TX_GET_ZCOPY);
 }
 
+static int uct_scopy_ep_tx_split_start(uct_scopy_iface_t *iface,
+                                       uct_scopy_tx_t *tx)
+{
+    size_t length;
+
+    if ((iface->helpers.count == 0) || (iface->helpers.tx != NULL) ||
+        (tx->iov_iter.iov_index != 0) || (tx->iov_iter.buffer_offset != 0)) {
+        return 0;
+    }
+
+    length = uct_iov_total_length(tx->iov, tx->iov_cnt);
+    if (length < iface->config.tx_threads_thresh) {
+        return 0;
+    }
+
+    tx->split.offset = 0;
+    tx->split.done   = 0;
+    tx->split.length = length;
+    tx->split.status = UCS_OK;
+
+    pthread_mutex_lock(&iface->helpers.lock);
+    iface->helpers.tx = tx;
+    pthread_cond_broadcast(&iface->helpers.cond);
+    pthread_mutex_unlock(&iface->helpers.lock);
+    return 1;
+}
+
+/* Copy one chunk of a transfer which is split among the helper threads.
+ * Returns nonzero if the transfer is complete and can be released. */
+static int uct_scopy_ep_tx_split_progress(uct_scopy_iface_t *iface,
+                                          uct_scopy_tx_t *tx)
+{
+    size_t offset, length;
+    ucs_status_t status;
+    int busy;
+
+    offset = ucs_atomic_fadd64(&tx->split.offset, iface->config.seg_size);
+    if (offset < tx->split.length) {
+        length = ucs_min(iface->config.seg_size, tx->split.length - offset);
+        status = uct_scopy_iface_tx_copy(iface, tx, offset, length);
+        if (status != UCS_OK) {
+            tx->split.status = status;
+        }
+
+        ucs_atomic_add64(&tx->split.done, length);
+    }
+
+    if (tx->split.done < tx->split.length) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&iface->helpers.lock);
+    busy = (iface->helpers.busy > 0);
+    if (!busy) {
+        iface->helpers.tx = NULL;
+    }
+    pthread_mutex_unlock(&iface->helpers.lock);
+
+    return !busy;
+}
+
 ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
                                                  ucs_arbiter_group_t *group,
                                                  ucs_arbiter_elem_t *elem,
@@ -147,6 +219,18 @@ ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
     if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
         ucs_assert((tx->op == UCT_SCOPY_TX_GET_ZCOPY) ||
                    (tx->op == UCT_SCOPY_TX_PUT_ZCOPY));
+        if ((tx->split.length != 0) ||
+            uct_scopy_ep_tx_split_start(iface, tx)) {
+            (*count)++;
+            if (!uct_scopy_ep_tx_split_progress(iface, tx)) {
+                return UCS_ARBITER_CB_RESULT_RESCHED_GROUP;
+            }
+
+            status = tx->split.status;
+            uct_scopy_trace_data(tx);
+            goto out_complete;
+        }
+
         seg_size = iface->config.seg_size;
         status   = iface->tx(&ep->super.super, tx->iov, tx->iov_cnt,
                              &tx->iov_iter, &seg_size, tx->remote_addr,
@@ -166,6 +250,7 @@ ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
         }
     }
 
+out_complete:
     ucs_assert((tx->comp != NULL) ||
                (tx->op != UCT_SCOPY_TX_FLUSH_COMP));
     if (tx->comp != NULL) {
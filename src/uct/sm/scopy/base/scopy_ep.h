@@ -55,6 +55,14 @@ typedef struct uct_scopy_tx {
     uct_rkey_t                      rkey;               /* User-passed UCT rkey */
     uct_completion_t                *comp;              /* The pointer to the user's passed completion */
     ucs_iov_iter_t                  iov_iter;           /* UCT IOVs iterator */
+    struct {
+        uct_ep_h                    ep;                 /* EP which issued the transfer */
+        volatile uint64_t           offset;             /* Next chunk to copy */
+        volatile uint64_t           done;               /* Length of copied chunks */
+        size_t                      length;             /* Total length, 0 if the
+                                                         * transfer is not split */
+        ucs_status_t                status;             /* Status of failed chunk */
+    } split;                                            /* Copying by helper threads */
     size_t                          iov_cnt;            /* The number of the UCT IOVs */
     uct_iov_t                       iov[];              /* UCT IOVs */
 } uct_scopy_tx_t;
@@ -10,8 +10,12 @@
 #include "scopy_iface.h"
 #include "scopy_ep.h"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/arch/cpu.h>
 #include <ucs/sys/string.h>
+#include <ucs/sys/sys.h>
+#include <uct/base/uct_iov.inl>
+#include <sched.h>
 
 #include <uct/sm/base/sm_iface.h>
 
@@ -40,6 +44,26 @@ ucs_config_field_t uct_scopy_iface_config_table[] = {
      "How many TX segments can be dispatched during iface progress",
      ucs_offsetof(uct_scopy_iface_config_t, tx_quota), UCS_CONFIG_TYPE_UINT},
 
+    {"TX_THREADS", "0",
+     "Number of helper threads which copy large GET/PUT Zcopy transfers in\n"
+     "parallel with the progress thread. A transfer is split to SEG_SIZE chunks,\n"
+     "which are copied by all helpers and by the progress thread, and the\n"
+     "operation completes when all chunks were copied. 0 disables the helpers.",
+     ucs_offsetof(uct_scopy_iface_config_t, tx_threads), UCS_CONFIG_TYPE_UINT},
+
+    {"TX_THREADS_THRESH", "4m",
+     "Minimal length of a GET/PUT Zcopy transfer which is copied by the helper\n"
+     "threads. Only one transfer at a time is split among the helpers, others\n"
+     "are copied by the progress thread.",
+     ucs_offsetof(uct_scopy_iface_config_t, tx_threads_thresh),
+     UCS_CONFIG_TYPE_MEMUNITS},
+
+    {"TX_THREADS_BIND", "y",
+     "Bind every helper thread to a separate CPU from the process affinity\n"
+     "mask, other than the CPU of the thread which creates the interface.",
+     ucs_offsetof(uct_scopy_iface_config_t, tx_threads_bind),
+     UCS_CONFIG_TYPE_BOOL},
+
     UCT_IFACE_MPOOL_CONFIG_FIELDS("TX_", -1, 8, "send",
                                   ucs_offsetof(uct_scopy_iface_config_t, tx_mpool), ""),
 
@@ -80,6 +104,199 @@ void uct_scopy_iface_query(uct_scopy_iface_t *iface, uct_iface_attr_t *iface_att
     iface_attr->latency                 = ucs_linear_func_make(80e-9, 0); /* 80 ns */
 }
 
+static void uct_scopy_iface_tx_iov_iter_seek(const uct_scopy_tx_t *tx,
+                                             size_t offset,
+                                             ucs_iov_iter_t *iov_iter)
+{
+    size_t length;
+
+    ucs_iov_iter_init(iov_iter);
+    for (; iov_iter->iov_index < tx->iov_cnt; ++iov_iter->iov_index) {
+        length = uct_iov_get_length(&tx->iov[iov_iter->iov_index]);
+        if (offset < length) {
+            iov_iter->buffer_offset = offset;
+            return;
+        }
+
+        offset -= length;
+    }
+}
+
+ucs_status_t uct_scopy_iface_tx_copy(uct_scopy_iface_t *iface,
+                                     uct_scopy_tx_t *tx, size_t offset,
+                                     size_t length)
+{
+    ucs_iov_iter_t iov_iter;
+    ucs_status_t status;
+    size_t seg_size;
+
+    while (length > 0) {
+        /* seek on every iteration, since the transport may copy less than
+         * the IOV iterator was advanced by */
+        uct_scopy_iface_tx_iov_iter_seek(tx, offset, &iov_iter);
+        seg_size = length;
+        status   = iface->tx(tx->split.ep, tx->iov, tx->iov_cnt, &iov_iter,
+                             &seg_size, tx->remote_addr + offset, tx->rkey,
+                             tx->op);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        ucs_assert(seg_size <= length);
+        offset += seg_size;
+        length -= seg_size;
+    }
+
+    return UCS_OK;
+}
+
+static void *uct_scopy_iface_helper_thread_func(void *arg)
+{
+    uct_scopy_iface_t *iface = arg;
+    uct_scopy_tx_t *tx;
+    size_t offset, length;
+    ucs_status_t status;
+
+    pthread_mutex_lock(&iface->helpers.lock);
+    while (!iface->helpers.stop) {
+        tx = iface->helpers.tx;
+        if ((tx == NULL) || (tx->split.offset >= tx->split.length)) {
+            pthread_cond_wait(&iface->helpers.cond, &iface->helpers.lock);
+            continue;
+        }
+
+        /* 'tx' is not released while the helpers are busy with it */
+        ++iface->helpers.busy;
+        pthread_mutex_unlock(&iface->helpers.lock);
+
+        for (;;) {
+            offset = ucs_atomic_fadd64(&tx->split.offset,
+                                       iface->config.seg_size);
+            if (offset >= tx->split.length) {
+                break;
+            }
+
+            length = ucs_min(iface->config.seg_size, tx->split.length - offset);
+            status = uct_scopy_iface_tx_copy(iface, tx, offset, length);
+            if (status != UCS_OK) {
+                tx->split.status = status;
+            }
+
+            ucs_atomic_add64(&tx->split.done, length);
+        }
+
+        pthread_mutex_lock(&iface->helpers.lock);
+        --iface->helpers.busy;
+    }
+    pthread_mutex_unlock(&iface->helpers.lock);
+
+    return NULL;
+}
+
+void uct_scopy_iface_helpers_release(uct_scopy_iface_t *iface)
+{
+    uct_scopy_tx_t *tx = iface->helpers.tx;
+
+    ucs_assert(tx != NULL);
+
+    /* prevent the helpers from taking more chunks, and wait for them to leave
+     * the transfer */
+    tx->split.offset = tx->split.length;
+    pthread_mutex_lock(&iface->helpers.lock);
+    while (iface->helpers.busy > 0) {
+        pthread_mutex_unlock(&iface->helpers.lock);
+        sched_yield();
+        pthread_mutex_lock(&iface->helpers.lock);
+    }
+    iface->helpers.tx = NULL;
+    pthread_mutex_unlock(&iface->helpers.lock);
+}
+
+static void uct_scopy_iface_helpers_stop(uct_scopy_iface_t *iface)
+{
+    unsigned i;
+
+    pthread_mutex_lock(&iface->helpers.lock);
+    iface->helpers.stop = 1;
+    pthread_cond_broadcast(&iface->helpers.cond);
+    pthread_mutex_unlock(&iface->helpers.lock);
+
+    for (i = 0; i < iface->helpers.count; ++i) {
+        pthread_join(iface->helpers.threads[i], NULL);
+    }
+
+    ucs_free(iface->helpers.threads);
+    pthread_cond_destroy(&iface->helpers.cond);
+    pthread_mutex_destroy(&iface->helpers.lock);
+}
+
+static void uct_scopy_iface_helpers_start(uct_scopy_iface_t *iface,
+                                          const uct_scopy_iface_config_t *config)
+{
+    ucs_sys_cpuset_t parent_set, thread_set;
+    int cpu, bind, ret;
+    pthread_attr_t attr;
+    unsigned i;
+
+    iface->helpers.threads = NULL;
+    iface->helpers.count   = 0;
+    iface->helpers.tx      = NULL;
+    iface->helpers.busy    = 0;
+    iface->helpers.stop    = 0;
+    pthread_mutex_init(&iface->helpers.lock, NULL);
+    pthread_cond_init(&iface->helpers.cond, NULL);
+
+    if (config->tx_threads == 0) {
+        return;
+    }
+
+    iface->helpers.threads = ucs_calloc(config->tx_threads,
+                                        sizeof(*iface->helpers.threads),
+                                        "scopy helper threads");
+    if (iface->helpers.threads == NULL) {
+        ucs_diag("failed to allocate %u scopy helper threads",
+                 config->tx_threads);
+        return;
+    }
+
+    /* bind the helpers to the allowed CPUs other than the current one, in a
+     * round-robin order */
+    bind = 0;
+    cpu  = sched_getcpu();
+    if (config->tx_threads_bind && (ucs_sys_getaffinity(&parent_set) == 0)) {
+        if (cpu >= 0) {
+            CPU_CLR(cpu, &parent_set);
+        }
+        bind = (CPU_COUNT(&parent_set) > 0);
+    }
+
+    pthread_attr_init(&attr);
+    for (i = 0; i < config->tx_threads; ++i) {
+        if (bind) {
+            do {
+                cpu = (cpu + 1) % CPU_SETSIZE;
+            } while (!CPU_ISSET(cpu, &parent_set));
+
+            CPU_ZERO(&thread_set);
+            CPU_SET(cpu, &thread_set);
+            pthread_attr_setaffinity_np(&attr, sizeof(thread_set), &thread_set);
+        }
+
+        ret = pthread_create(&iface->helpers.threads[i], &attr,
+                             uct_scopy_iface_helper_thread_func, iface);
+        if (ret != 0) {
+            ucs_diag("pthread_create() returned %d, using %u scopy helper "
+                     "threads", ret, i);
+            break;
+        }
+
+        ucs_debug("scopy iface %p: started helper thread %u, cpu %d", iface,
+                  i, bind ? cpu : -1);
+        ++iface->helpers.count;
+    }
+    pthread_attr_destroy(&attr);
+}
+
 UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_scopy_iface_ops_t *ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
                     const uct_iface_config_t *tl_config)
@@ -95,6 +312,7 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_scopy_iface_ops_t *ops, uct_md_h md,
     self->config.max_iov  = ucs_min(config->max_iov, ucs_iov_get_max());
     self->config.seg_size = config->seg_size;
     self->config.tx_quota = config->tx_quota;
+    self->config.tx_threads_thresh = config->tx_threads_thresh;
 
     elem_size             = sizeof(uct_scopy_tx_t) +
                             self->config.max_iov * sizeof(uct_iov_t);
@@ -107,12 +325,17 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_scopy_iface_ops_t *ops, uct_md_h md,
                             config->tx_mpool.max_bufs,
                             &uct_scopy_mpool_ops,
                             "uct_scopy_iface_tx_mp");
+    if (status != UCS_OK) {
+        return status;
+    }
 
-    return status;
+    uct_scopy_iface_helpers_start(self, config);
+    return UCS_OK;
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_scopy_iface_t)
 {
+    uct_scopy_iface_helpers_stop(self);
     uct_worker_progress_unregister_safe(&self->super.super.worker->super,
                                         &self->super.super.prog.id);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
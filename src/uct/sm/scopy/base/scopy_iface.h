@@ -10,6 +10,7 @@
 
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_iface.h>
+#include <pthread.h>
 
 #define uct_scopy_trace_data(_tx) \
     ucs_trace_data("%s [tx %p iov %zu/%zu length %zu/%zu] to %"PRIx64"(%+ld)", \
@@ -31,6 +32,10 @@ typedef struct uct_scopy_iface_config {
                                                * data transfer for RMA operations */
     unsigned                      tx_quota;   /* How many TX segments can be dispatched
                                                * during iface progress */
+    unsigned                      tx_threads; /* Number of helper copy threads */
+    size_t                        tx_threads_thresh; /* Minimal length of a transfer
+                                                      * split among helper threads */
+    int                           tx_threads_bind; /* Bind helper threads to CPUs */
     uct_iface_mpool_config_t      tx_mpool;   /* TX memory pool configuration */
 } uct_scopy_iface_config_t;
 
@@ -40,6 +45,16 @@ typedef struct uct_scopy_iface {
     ucs_arbiter_t                 arbiter;     /* TX arbiter */
     ucs_mpool_t                   tx_mpool;    /* TX memory pool */
     uct_scopy_ep_tx_func_t        tx;          /* TX function */
+    struct {
+        pthread_t                 *threads;    /* Helper copy threads */
+        unsigned                  count;       /* Number of helper threads */
+        pthread_mutex_t           lock;        /* Protects the fields below */
+        pthread_cond_t            cond;        /* Signaled on new transfer or stop */
+        uct_scopy_tx_t            *tx;         /* Transfer which is split among
+                                                * the helpers, or NULL */
+        unsigned                  busy;        /* Helpers working on 'tx' */
+        int                       stop;        /* Helpers should exit */
+    } helpers;
     struct {
         size_t                    max_iov;     /* Maximum supported IOVs limited by
                                                 * user configuration and system
@@ -49,6 +64,9 @@ typedef struct uct_scopy_iface {
                                                 * Zcopy transfers */
         unsigned                  tx_quota;    /* How many TX segments can be dispatched
                                                 * during iface progress */
+        size_t                    tx_threads_thresh; /* Minimal length of a
+                                                      * transfer which is split
+                                                      * among helper threads */
     } config;
 } uct_scopy_iface_t;
 
@@ -69,4 +87,10 @@ unsigned uct_scopy_iface_progress(uct_iface_h tl_iface);
 ucs_status_t uct_scopy_iface_flush(uct_iface_h tl_iface, unsigned flags,
                                    uct_completion_t *comp);
 
+ucs_status_t uct_scopy_iface_tx_copy(uct_scopy_iface_t *iface,
+                                     uct_scopy_tx_t *tx, size_t offset,
+                                     size_t length);
+
+void uct_scopy_iface_helpers_release(uct_scopy_iface_t *iface);
+
 #endif
@@ -13,6 +13,7 @@
 #include "cma_ep.h"
 #include <uct/base/uct_iov.inl>
 #include <ucs/debug/log.h>
+#include <ucs/sys/compiler.h>
 #include <ucs/sys/iovec.h>
 
 
@@ -61,15 +62,19 @@ ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
                            uct_scopy_tx_op_t tx_op)
 {
     uct_cma_ep_t *ep                   = ucs_derived_of(tl_ep, uct_cma_ep_t);
-    size_t local_iov_idx               = 0;
-    size_t UCS_V_UNUSED remote_iov_idx = 0;
-    size_t local_iov_cnt               = UCT_SM_MAX_IOV;
+    uct_scopy_iface_t *iface           = ucs_derived_of(tl_ep->iface,
+                                                        uct_scopy_iface_t);
+    size_t local_iov_cnt               = iface->config.max_iov;
+    ucs_iov_iter_t start_iov_iter      = *iov_iter;
+    struct iovec *local_iov, remote_iov;
     size_t total_iov_length;
-    struct iovec local_iov[UCT_SM_MAX_IOV], remote_iov;
     ssize_t ret;
 
     ucs_assert(*length_p != 0);
 
+    /* gather all local IOVs, up to the limit of the system, into a single
+     * process_vm_readv/writev call */
+    local_iov        = ucs_alloca(local_iov_cnt * sizeof(*local_iov));
     total_iov_length = uct_iov_to_iovec(local_iov, &local_iov_cnt,
                                         iov, iov_cnt, *length_p, iov_iter);
     ucs_assert((total_iov_length <= *length_p) && (total_iov_length != 0) &&
@@ -78,9 +83,8 @@ ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
     remote_iov.iov_base = (void*)(uintptr_t)remote_addr;
     remote_iov.iov_len  = total_iov_length;
 
-    ret = uct_cma_ep_fn[tx_op].fn(ep->remote_pid, &local_iov[local_iov_idx],
-                                  local_iov_cnt - local_iov_idx, &remote_iov,
-                                  1, 0);
+    ret = uct_cma_ep_fn[tx_op].fn(ep->remote_pid, local_iov, local_iov_cnt,
+                                  &remote_iov, 1, 0);
     if (ucs_unlikely(ret < 0)) {
         ucs_error("%s(pid=%d length=%zu) returned %zd: %m",
                   uct_cma_ep_fn[tx_op].name, ep->remote_pid,
@@ -90,6 +94,14 @@ ucs_status_t uct_cma_ep_tx(uct_ep_h tl_ep, const uct_iov_t *iov, size_t iov_cnt,
 
     ucs_assert(ret <= remote_iov.iov_len);
 
+    if (ucs_unlikely(ret < total_iov_length)) {
+        /* partial transfer - advance the iterator only by the copied length */
+        *iov_iter     = start_iov_iter;
+        local_iov_cnt = iface->config.max_iov;
+        uct_iov_to_iovec(local_iov, &local_iov_cnt, iov, iov_cnt, ret,
+                         iov_iter);
+    }
+
     *length_p = ret;
     return UCS_OK;
 }
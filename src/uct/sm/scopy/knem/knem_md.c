@@ -360,6 +360,8 @@ uct_knem_md_open(uct_component_t *component, const char *md_name,
         rcache_params.context            = knem_md;
         rcache_params.ops                = &uct_knem_rcache_ops;
         rcache_params.flags              = UCS_RCACHE_FLAG_PURGE_ON_FORK;
+        rcache_params.max_regions        = md_config->rcache.max_regions;
+        rcache_params.max_size           = md_config->rcache.max_size;
         status = ucs_rcache_create(&rcache_params, "knem rcache device",
                                    ucs_stats_get_root(), &knem_md->rcache);
         if (status == UCS_OK) {
@@ -20,6 +20,14 @@
 
 #include <net/if.h>
 
+#if HAVE_DECL_SO_ZEROCOPY && HAVE_DECL_MSG_ZEROCOPY && \
+    HAVE_DECL_SO_EE_ORIGIN_ZEROCOPY
+#  include <linux/errqueue.h>
+#  define UCT_TCP_HAVE_MSG_ZEROCOPY           1
+#else
+#  define UCT_TCP_HAVE_MSG_ZEROCOPY           0
+#endif
+
 #define UCT_TCP_NAME                          "tcp"
 
 #define UCT_TCP_CONFIG_PREFIX                 "TCP_"
@@ -50,8 +58,19 @@
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
 
+/* Length of a data that is used by GET protocol to send the response */
+#define UCT_TCP_EP_GET_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
+                                              sizeof(uct_tcp_ep_get_resp_hdr_t))
+
 #define UCT_TCP_CONFIG_MAX_CONN_RETRIES      "MAX_CONN_RETRIES"
 
+/* Maximal number of sockets which can be used to send data to a peer */
+#define UCT_TCP_EP_MAX_STREAMS               16
+
+/* Default size of send and receive buffers of Unix domain sockets, the kernel
+ * doesn't tune them automatically as it does for TCP */
+#define UCT_TCP_UNIX_SOCKBUF_SIZE            (4 * UCS_MBYTE)
+
 /* TX and RX caps */
 #define UCT_TCP_EP_CTX_CAPS                  (UCT_TCP_EP_FLAG_CTX_TYPE_TX | \
                                               UCT_TCP_EP_FLAG_CTX_TYPE_RX)
@@ -89,7 +108,25 @@ enum {
      * for received PUT operations on a given EP. */
     UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK = UCS_BIT(5),
     /* EP is on connection matching context. */
-    UCT_TCP_EP_FLAG_ON_MATCH_CTX       = UCS_BIT(6)
+    UCT_TCP_EP_FLAG_ON_MATCH_CTX       = UCS_BIT(6),
+    /* Zcopy TX operation in progress on a given EP is sent using
+     * MSG_ZEROCOPY, i.e. its completion has to be postponed until
+     * the notification is read from the socket error queue. */
+    UCT_TCP_EP_FLAG_MSG_ZCOPY_TX       = UCS_BIT(7),
+    /* EP is an additional stream of a user's EP which is used to send
+     * parts of large PUT Zcopy operations. The EP is hidden from a user
+     * and is destroyed together with the user's EP. */
+    UCT_TCP_EP_FLAG_STREAM             = UCS_BIT(8),
+    /* Fence was requested on the EP while its streams had PUT operations
+     * in-flight, so the EP mustn't send new data until the streams are
+     * drained. */
+    UCT_TCP_EP_FLAG_FENCE              = UCS_BIT(9),
+    /* GET Zcopy response payload is being received directly to the user's
+     * buffers on a given EP. */
+    UCT_TCP_EP_FLAG_GET_RX             = UCS_BIT(10),
+    /* EP's socket is a Unix domain socket connected to a peer on the same
+     * host, so TCP-specific socket features can't be used on it. */
+    UCT_TCP_EP_FLAG_UNIX               = UCS_BIT(11)
 };
 
 
@@ -161,9 +198,14 @@ typedef enum uct_tcp_cm_conn_event {
  * TCP connection request packet
  */
 typedef struct uct_tcp_cm_conn_req_pkt {
-    uct_tcp_cm_conn_event_t       event;      /* Connection event ID */
-    struct sockaddr_in            iface_addr; /* Socket address of UCT local iface */
-    uct_tcp_cm_conn_sn_t          conn_sn;    /* Connection sequence number */
+    uct_tcp_cm_conn_event_t       event;       /* Connection event ID */
+    struct sockaddr_in            iface_addr;  /* Socket address of UCT local iface */
+    uct_tcp_cm_conn_sn_t          conn_sn;     /* Connection sequence number */
+    uint8_t                       num_streams; /* Number of sockets used by each
+                                                * EP, must be the same on both
+                                                * peers, since the streams
+                                                * consume connection sequence
+                                                * numbers */
 } UCS_S_PACKED uct_tcp_cm_conn_req_pkt_t;
 
 
@@ -185,7 +227,11 @@ typedef enum uct_tcp_ep_am_id {
     /* AM ID reserved for TCP internal PUT REQ message */
     UCT_TCP_EP_PUT_REQ_AM_ID = UCT_AM_ID_MAX + 1,
     /* AM ID reserved for TCP internal PUT ACK message */
-    UCT_TCP_EP_PUT_ACK_AM_ID = UCT_AM_ID_MAX + 2
+    UCT_TCP_EP_PUT_ACK_AM_ID = UCT_AM_ID_MAX + 2,
+    /* AM ID reserved for TCP internal GET REQ message */
+    UCT_TCP_EP_GET_REQ_AM_ID  = UCT_AM_ID_MAX + 3,
+    /* AM ID reserved for TCP internal GET RESP message */
+    UCT_TCP_EP_GET_RESP_AM_ID = UCT_AM_ID_MAX + 4
 } uct_tcp_ep_am_id_t;
 
 
@@ -207,6 +253,56 @@ typedef struct uct_tcp_ep_put_ack_hdr {
 } UCS_S_PACKED uct_tcp_ep_put_ack_hdr_t;
 
 
+/**
+ * TCP GET request header
+ */
+typedef struct uct_tcp_ep_get_req_hdr {
+    uint64_t                      addr;        /* Address of a remote memory buffer */
+    size_t                        length;      /* Length of a remote memory buffer */
+} UCS_S_PACKED uct_tcp_ep_get_req_hdr_t;
+
+
+/**
+ * TCP GET response header, followed by the data read from the remote buffer
+ */
+typedef struct uct_tcp_ep_get_resp_hdr {
+    size_t                        length;      /* Length of the data */
+    int8_t                        status;      /* Status of the request, the
+                                                * data follows only if it is
+                                                * UCS_OK */
+} UCS_S_PACKED uct_tcp_ep_get_resp_hdr_t;
+
+
+/**
+ * TCP GET operation which waits for the response from the peer, allocated
+ * from TX memory pool
+ */
+typedef struct uct_tcp_ep_get_op {
+    ucs_queue_elem_t              queue;       /* Element to insert the operation
+                                                * into TCP EP GET operations queue */
+    uct_completion_t              *comp;       /* Local UCT completion object */
+    size_t                        length;      /* Length of the data that still
+                                                * has to be received */
+    size_t                        iov_index;   /* Current IOV index */
+    size_t                        iov_cnt;     /* Number of IOVs to receive the
+                                                * data to, 0 if the operation was
+                                                * canceled and the data is dropped */
+    struct iovec                  iov[0];      /* IOVs to receive the data to */
+} uct_tcp_ep_get_op_t;
+
+
+/**
+ * TCP GET request received from the peer. The response is sent from TX
+ * progress, since sending it from RX progress could fail the EP while
+ * the received messages are still being parsed.
+ */
+typedef struct uct_tcp_ep_get_resp {
+    ucs_queue_elem_t              queue;       /* Element to insert the request
+                                                * into TCP EP GET responses queue */
+    uct_tcp_ep_get_req_hdr_t      req;         /* GET request */
+} uct_tcp_ep_get_resp_t;
+
+
 /**
  * TCP PUT completion
  */
@@ -216,11 +312,34 @@ typedef struct uct_tcp_ep_put_completion {
     uint32_t                      wait_put_sn;     /* Sequence number of the last unacked
                                                     * PUT operations that was in-progress
                                                     * when uct_ep_flush was called */
+    uint32_t                      wait_msg_zcopy_sn; /* Notification ID of the last
+                                                      * MSG_ZEROCOPY send that was
+                                                      * in-progress when uct_ep_flush
+                                                      * was called */
+    uint32_t                      wait_get_sn;     /* Sequence number of the last
+                                                    * GET operation that was
+                                                    * in-progress when uct_ep_flush
+                                                    * was called */
     ucs_queue_elem_t              elem;            /* Element to insert completion into
                                                     * TCP EP PUT operation pending queue */
 } uct_tcp_ep_put_completion_t;
 
 
+/**
+ * TCP completion of an operation which is split between several EPs
+ */
+typedef struct uct_tcp_ep_multi_comp {
+    uct_completion_t              super;           /* Completion which is invoked
+                                                    * by each part */
+    uct_completion_t              *comp;           /* User's completion, NULL if
+                                                    * the operation failed */
+    unsigned                      count;           /* Number of parts which are
+                                                    * not completed yet */
+    ucs_status_t                  status;          /* First error reported by
+                                                    * the parts */
+} uct_tcp_ep_multi_comp_t;
+
+
 /**
  * TCP endpoint communication context
  */
@@ -241,6 +360,10 @@ typedef struct uct_tcp_ep_ctx {
 typedef struct uct_tcp_ep_zcopy_tx {
     uct_tcp_am_hdr_t              super;     /* UCT TCP AM header */
     uct_completion_t              *comp;     /* Local UCT completion object */
+    ucs_queue_elem_t              queue;     /* Element to insert the context into
+                                              * TCP EP MSG_ZEROCOPY completion queue */
+    uint32_t                      msg_zcopy_sn; /* Notification ID of the last
+                                                 * MSG_ZEROCOPY send of the operation */
     size_t                        iov_index; /* Current IOV index */
     size_t                        iov_cnt;   /* Number of IOVs that should be sent */
     struct iovec                  iov[0];    /* IOVs that should be sent */
@@ -252,7 +375,7 @@ typedef struct uct_tcp_ep_zcopy_tx {
  */
 struct uct_tcp_ep {
     uct_base_ep_t                 super;
-    uint8_t                       flags;            /* Endpoint flags */
+    uint16_t                      flags;            /* Endpoint flags */
     uint8_t                       conn_retries;     /* Number of connection attempts done */
     uct_tcp_ep_conn_state_t       conn_state;       /* State of connection with peer */
     int                           fd;               /* Socket file descriptor */
@@ -266,7 +389,36 @@ struct uct_tcp_ep {
     struct sockaddr_in            peer_addr;        /* Remote iface addr */
     ucs_queue_head_t              pending_q;        /* Pending operations */
     ucs_queue_head_t              put_comp_q;       /* Flush completions waiting for
-                                                     * outstanding PUTs acknowledgment */
+                                                     * outstanding PUTs acknowledgment
+                                                     * and MSG_ZEROCOPY notifications */
+    uint32_t                      put_ack_sn;       /* Sequence number of the last
+                                                     * acknowledged PUT operation */
+    struct {
+        ucs_queue_head_t          queue;            /* Zcopy operations which were sent
+                                                     * completely, but are waiting for
+                                                     * MSG_ZEROCOPY notifications */
+        uint32_t                  sn;               /* Notification ID that will be
+                                                     * assigned to the next MSG_ZEROCOPY
+                                                     * send on the socket */
+        uint32_t                  completed_sn;     /* Notification ID of the last
+                                                     * completed MSG_ZEROCOPY send */
+    } msg_zcopy;
+    struct {
+        ucs_queue_head_t          ops;              /* GET operations waiting for
+                                                     * responses from the peer */
+        uint32_t                  sn;               /* Sequence number of the last
+                                                     * started GET operation */
+        uint32_t                  completed_sn;     /* Sequence number of the last
+                                                     * completed GET operation */
+        ucs_queue_head_t          resp_q;           /* GET requests from the peer
+                                                     * waiting for TX resources to
+                                                     * send the responses */
+    } get;
+    struct {
+        uct_tcp_ep_t              **eps;            /* Additional EPs which are
+                                                     * connected to the same peer */
+        unsigned                  count;            /* Number of additional EPs */
+    } streams;
     union {
         ucs_list_link_t           list;             /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;             /* Connection matching element */
@@ -280,8 +432,13 @@ struct uct_tcp_ep {
 typedef struct uct_tcp_iface {
     uct_base_iface_t              super;             /* Parent class */
     int                           listen_fd;         /* Server socket */
+    int                           unix_listen_fd;    /* Unix domain server socket for
+                                                      * peers on the same host */
     ucs_conn_match_ctx_t          conn_match_ctx;    /* Connection matching context */
     ucs_list_link_t               ep_list;           /* List of endpoints */
+    ucs_list_link_t               stream_gc_list;    /* Streams of failed EPs which
+                                                      * are destroyed from the
+                                                      * iface progress */
     char                          if_name[IFNAMSIZ]; /* Network interface name */
     ucs_sys_event_set_t           *event_set;        /* Event set identifier */
     ucs_mpool_t                   tx_mpool;          /* TX memory pool */
@@ -290,7 +447,10 @@ typedef struct uct_tcp_iface {
                                                       * + how many non-blocking connections
                                                       * are in progress + how many EPs are
                                                       * waiting for PUT Zcopy operation ACKs
-                                                      * (0/1 for each EP) */
+                                                      * (0/1 for each EP) + how many Zcopy
+                                                      * operations are waiting for MSG_ZEROCOPY
+                                                      * notifications + how many GET Zcopy
+                                                      * operations are waiting for responses */
 
     struct {
         size_t                    tx_seg_size;       /* TX AM buffer size */
@@ -304,12 +464,22 @@ typedef struct uct_tcp_iface {
             size_t                max_hdr;           /* Maximum supported AM Zcopy header */
             size_t                hdr_offset;        /* Offset in TX buffer to empty space that
                                                       * can be used for AM Zcopy header */
+            size_t                msg_zcopy_thresh;  /* Minimal payload length of Zcopy
+                                                      * operation which is sent using
+                                                      * MSG_ZEROCOPY, SIZE_MAX - disabled */
         } zcopy;
+        unsigned                  num_streams;       /* Number of sockets used to send
+                                                      * data to a peer */
+        size_t                    stripe_min_size;   /* Minimal length of a PUT Zcopy
+                                                      * part sent on a separate socket */
         struct sockaddr_in        ifaddr;            /* Network address */
         struct sockaddr_in        netmask;           /* Network address mask */
         int                       prefer_default;    /* Prefer default gateway */
         int                       put_enable;        /* Enable PUT Zcopy operation support */
+        int                       get_enable;        /* Enable GET Zcopy operation support */
         int                       conn_nb;           /* Use non-blocking connect() */
+        int                       unix_enable;       /* Use Unix domain sockets to
+                                                      * connect to peers on the same host */
         unsigned                  max_poll;          /* Number of events to poll per socket*/
         uint8_t                   max_conn_retries;  /* How many connection establishment attempts
                                                       * should be done if dropped connection was
@@ -323,6 +493,9 @@ typedef struct uct_tcp_iface {
         int                       nodelay;           /* TCP_NODELAY */
         size_t                    sndbuf;            /* SO_SNDBUF */
         size_t                    rcvbuf;            /* SO_RCVBUF */
+        int                       busy_poll;         /* SO_BUSY_POLL, in usec,
+                                                      * 0 - disabled */
+        int                       prefer_busy_poll;  /* SO_PREFER_BUSY_POLL */
     } sockopt;
 } uct_tcp_iface_t;
 
@@ -336,13 +509,20 @@ typedef struct uct_tcp_iface_config {
     size_t                         rx_seg_size;
     size_t                         max_iov;
     size_t                         sendv_thresh;
+    size_t                         msg_zcopy_thresh;
+    unsigned                       num_streams;
+    size_t                         stripe_min_size;
     int                            prefer_default;
     int                            put_enable;
+    int                            get_enable;
     int                            conn_nb;
+    int                            unix_enable;
     unsigned                       max_poll;
     unsigned                       max_conn_retries;
     int                            sockopt_nodelay;
     uct_tcp_send_recv_buf_config_t sockopt;
+    double                         sockopt_busy_poll;
+    int                            sockopt_prefer_busy_poll;
     unsigned                       syn_cnt;
     uct_iface_mpool_config_t       tx_mpool;
     uct_iface_mpool_config_t       rx_mpool;
@@ -366,7 +546,11 @@ ucs_status_t uct_tcp_netif_is_default(const char *if_name, int *result_p);
 int uct_tcp_sockaddr_cmp(const struct sockaddr *sa1,
                          const struct sockaddr *sa2);
 
-ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd);
+ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
+                                       int is_unix);
+
+ucs_status_t uct_tcp_iface_unix_connect(uct_tcp_iface_t *iface, int fd,
+                                        const struct sockaddr_in *peer_addr);
 
 size_t uct_tcp_iface_get_max_iov(const uct_tcp_iface_t *iface);
 
@@ -376,6 +560,8 @@ void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep);
 
 void uct_tcp_iface_remove_ep(uct_tcp_ep_t *ep);
 
+void uct_tcp_iface_stream_gc(uct_tcp_iface_t *iface);
+
 int uct_tcp_iface_is_self_addr(uct_tcp_iface_t *iface,
                                const struct sockaddr_in *peer_addr);
 
@@ -389,16 +575,16 @@ ucs_status_t uct_tcp_ep_init(uct_tcp_iface_t *iface, int fd,
 ucs_status_t uct_tcp_ep_create(const uct_ep_params_t *params,
                                uct_ep_h *ep_p);
 
-const char *uct_tcp_ep_ctx_caps_str(uint8_t ep_ctx_caps, char *str_buffer);
+const char *uct_tcp_ep_ctx_caps_str(uint16_t ep_ctx_caps, char *str_buffer);
 
-void uct_tcp_ep_change_ctx_caps(uct_tcp_ep_t *ep, uint8_t new_caps);
+void uct_tcp_ep_change_ctx_caps(uct_tcp_ep_t *ep, uint16_t new_caps);
 
-void uct_tcp_ep_add_ctx_cap(uct_tcp_ep_t *ep, uint8_t cap);
+void uct_tcp_ep_add_ctx_cap(uct_tcp_ep_t *ep, uint16_t cap);
 
-void uct_tcp_ep_remove_ctx_cap(uct_tcp_ep_t *ep, uint8_t cap);
+void uct_tcp_ep_remove_ctx_cap(uct_tcp_ep_t *ep, uint16_t cap);
 
 void uct_tcp_ep_move_ctx_cap(uct_tcp_ep_t *from_ep, uct_tcp_ep_t *to_ep,
-                             uint8_t ctx_cap);
+                             uint16_t ctx_cap);
 
 void uct_tcp_ep_destroy_internal(uct_ep_h tl_ep);
 
@@ -416,6 +602,8 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, int add, int remove);
 
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep);
 
+unsigned uct_tcp_ep_progress_msg_zcopy(uct_tcp_ep_t *ep);
+
 ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header,
                                  const void *payload, unsigned length);
 
@@ -428,6 +616,10 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
                                  size_t iovcnt, unsigned flags,
                                  uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp);
@@ -438,6 +630,8 @@ ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
 void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
                               void *arg);
 
+ucs_status_t uct_tcp_ep_fence(uct_ep_h tl_ep, unsigned flags);
+
 ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp);
 
@@ -463,14 +657,14 @@ uct_tcp_cm_get_conn_sn(uct_tcp_iface_t *iface,
 uct_tcp_ep_t *uct_tcp_cm_get_ep(uct_tcp_iface_t *iface,
                                 const struct sockaddr_in *dest_address,
                                 uct_tcp_cm_conn_sn_t conn_sn,
-                                uint8_t with_ctx_cap);
+                                uint16_t with_ctx_cap);
 
 void uct_tcp_cm_insert_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep);
 
 void uct_tcp_cm_remove_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep);
 
 ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
-                                             const struct sockaddr_in *peer_addr,
+                                             const struct sockaddr *peer_addr,
                                              int fd);
 
 ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep);
@@ -10,8 +10,46 @@
 #include "tcp.h"
 
 #include <ucs/async/async.h>
+#include <sched.h>
 
 
+static void uct_tcp_cm_log_rx_affinity(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    ucs_log_level_t log_level;
+    int rx_cpu, napi_id;
+    socklen_t optlen;
+
+    /* In the latency mode, the placement of the RX queue interrupts relative
+     * to the polling thread matters, so make it visible on the diag level */
+    log_level = (iface->sockopt.busy_poll != 0) ? UCS_LOG_LEVEL_DIAG :
+                                                  UCS_LOG_LEVEL_DEBUG;
+    if (!ucs_log_is_enabled(log_level) || (ep->flags & UCT_TCP_EP_FLAG_UNIX)) {
+        return;
+    }
+
+    rx_cpu  = -1;
+    napi_id = 0;
+#if HAVE_DECL_SO_INCOMING_CPU
+    optlen = sizeof(rx_cpu);
+    if (getsockopt(ep->fd, SOL_SOCKET, SO_INCOMING_CPU, &rx_cpu,
+                   &optlen) < 0) {
+        rx_cpu = -1;
+    }
+#endif
+#if HAVE_DECL_SO_INCOMING_NAPI_ID
+    optlen = sizeof(napi_id);
+    if (getsockopt(ep->fd, SOL_SOCKET, SO_INCOMING_NAPI_ID, &napi_id,
+                   &optlen) < 0) {
+        napi_id = 0;
+    }
+#endif
+
+    ucs_log(log_level, "tcp_ep %p: fd %d receives on cpu %d napi_id %d, "
+            "polled from cpu %d", ep, ep->fd, rx_cpu, napi_id, sched_getcpu());
+}
+
 void uct_tcp_cm_change_conn_state(uct_tcp_ep_t *ep,
                                   uct_tcp_ep_conn_state_t new_conn_state)
 {
@@ -44,6 +82,7 @@ void uct_tcp_cm_change_conn_state(uct_tcp_ep_t *ep,
                    (old_conn_state == UCT_TCP_EP_CONN_STATE_WAITING_ACK) ||
                    (old_conn_state == UCT_TCP_EP_CONN_STATE_ACCEPTING));
         uct_tcp_iface_outstanding_dec(iface);
+        uct_tcp_cm_log_rx_affinity(ep);
         if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX) {
             /* Progress possibly pending TX operations */
             uct_tcp_ep_pending_queue_dispatch(ep);
@@ -179,10 +218,11 @@ ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep,
             *(uint64_t*)pkt_buf = UCT_TCP_MAGIC_NUMBER;
         }
 
-        conn_pkt             = (uct_tcp_cm_conn_req_pkt_t*)(pkt_hdr + 1);
-        conn_pkt->event      = UCT_TCP_CM_CONN_REQ;
-        conn_pkt->iface_addr = iface->config.ifaddr;
-        conn_pkt->conn_sn    = ep->conn_sn;
+        conn_pkt              = (uct_tcp_cm_conn_req_pkt_t*)(pkt_hdr + 1);
+        conn_pkt->event       = UCT_TCP_CM_CONN_REQ;
+        conn_pkt->iface_addr  = iface->config.ifaddr;
+        conn_pkt->conn_sn     = ep->conn_sn;
+        conn_pkt->num_streams = iface->config.num_streams;
         ucs_assert(ep->conn_sn < UCT_TCP_CM_CONN_SN_MAX);
     } else {
         pkt_event            = (uct_tcp_cm_conn_event_t*)(pkt_hdr + 1);
@@ -261,7 +301,7 @@ uct_tcp_cm_get_conn_sn(uct_tcp_iface_t *iface,
 uct_tcp_ep_t *uct_tcp_cm_get_ep(uct_tcp_iface_t *iface,
                                 const struct sockaddr_in *dest_address,
                                 uct_tcp_cm_conn_sn_t conn_sn,
-                                uint8_t with_ctx_cap)
+                                uint16_t with_ctx_cap)
 {
     ucs_conn_match_queue_type_t queue_type;
     ucs_conn_match_elem_t *elem;
@@ -306,7 +346,7 @@ uct_tcp_ep_t *uct_tcp_cm_get_ep(uct_tcp_iface_t *iface,
 
 void uct_tcp_cm_insert_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
 {
-    uint8_t ctx_caps = ep->flags & UCT_TCP_EP_CTX_CAPS;
+    uint16_t ctx_caps = ep->flags & UCT_TCP_EP_CTX_CAPS;
 
     ucs_assert(ep->conn_sn < UCT_TCP_CM_CONN_SN_MAX);
     ucs_assert((ctx_caps & UCT_TCP_EP_FLAG_CTX_TYPE_TX) ||
@@ -324,7 +364,7 @@ void uct_tcp_cm_insert_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
 
 void uct_tcp_cm_remove_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
 {
-    uint8_t ctx_caps = ep->flags & UCT_TCP_EP_CTX_CAPS;
+    uint16_t ctx_caps = ep->flags & UCT_TCP_EP_CTX_CAPS;
 
     ucs_assert(ep->conn_sn < UCT_TCP_CM_CONN_SN_MAX);
     ucs_assert(ctx_caps != 0);
@@ -466,6 +506,7 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
     uct_tcp_iface_t *iface  = ucs_derived_of(ep->super.super.iface,
                                              uct_tcp_iface_t);
     unsigned progress_count = 0;
+    char str_addr[UCS_SOCKADDR_STRING_LEN];
     ucs_status_t status;
     uct_tcp_ep_t *peer_ep;
     int connect_to_self;
@@ -486,6 +527,19 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
     uct_tcp_cm_trace_conn_pkt(ep, UCS_LOG_LEVEL_TRACE,
                               "%s received from", UCT_TCP_CM_CONN_REQ);
 
+    if (cm_req_pkt->num_streams != iface->config.num_streams) {
+        /* Connections of the peers would be matched to wrong EPs, since the
+         * streams of each EP consume connection sequence numbers */
+        ucs_error("tcp_ep %p: rejecting connection from %s which uses %u "
+                  "streams per endpoint, while %u are used locally, %s%s"
+                  "NUM_STREAMS must be the same on all peers", ep,
+                  ucs_sockaddr_str((const struct sockaddr*)&ep->peer_addr,
+                                   str_addr, UCS_SOCKADDR_STRING_LEN),
+                  cm_req_pkt->num_streams, iface->config.num_streams,
+                  UCS_DEFAULT_ENV_PREFIX, UCT_TCP_CONFIG_PREFIX);
+        goto out;
+    }
+
     uct_tcp_ep_add_ctx_cap(ep, UCT_TCP_EP_FLAG_CTX_TYPE_RX);
 
     if (ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) {
@@ -614,6 +668,34 @@ err:
     return 0;
 }
 
+/* Replace the Unix domain socket of the EP by a TCP socket, if the peer
+ * can't be reached through the Unix domain socket */
+static ucs_status_t uct_tcp_cm_unix_fallback(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    ucs_status_t status;
+
+    ucs_assertv(ep->events == 0, "ep=%p", ep);
+
+    ucs_close_fd(&ep->fd);
+    ep->flags &= ~UCT_TCP_EP_FLAG_UNIX;
+
+    status = ucs_socket_create(AF_INET, SOCK_STREAM, &ep->fd);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if (iface->config.conn_nb) {
+        status = ucs_sys_fcntl_modfl(ep->fd, O_NONBLOCK, 0);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    return uct_tcp_iface_set_sockopt(iface, ep->fd, 0);
+}
+
 ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -628,15 +710,31 @@ ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep)
 
     uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CONNECTING);
 
-    status = ucs_socket_connect(ep->fd, (const struct sockaddr*)&ep->peer_addr);
-    if (UCS_STATUS_IS_ERR(status)) {
-        return status;
-    } else if (status == UCS_INPROGRESS) {
-        uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
-        return UCS_OK;
+    if (ep->flags & UCT_TCP_EP_FLAG_UNIX) {
+        status = uct_tcp_iface_unix_connect(iface, ep->fd, &ep->peer_addr);
+        if (status == UCS_INPROGRESS) {
+            uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+            return UCS_OK;
+        } else if (status != UCS_OK) {
+            status = uct_tcp_cm_unix_fallback(ep);
+            if (status != UCS_OK) {
+                return status;
+            }
+        }
     }
 
-    ucs_assert(status == UCS_OK);
+    if (!(ep->flags & UCT_TCP_EP_FLAG_UNIX)) {
+        status = ucs_socket_connect(ep->fd,
+                                    (const struct sockaddr*)&ep->peer_addr);
+        if (UCS_STATUS_IS_ERR(status)) {
+            return status;
+        } else if (status == UCS_INPROGRESS) {
+            uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+            return UCS_OK;
+        }
+
+        ucs_assert(status == UCS_OK);
+    }
 
     if (!iface->config.conn_nb) {
         status = ucs_sys_fcntl_modfl(ep->fd, O_NONBLOCK, 0);
@@ -650,7 +748,7 @@ ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep)
 
 /* This function is called from async thread */
 ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
-                                             const struct sockaddr_in *peer_addr,
+                                             const struct sockaddr *peer_addr,
                                              int fd)
 {
     char str_local_addr[UCS_SOCKADDR_STRING_LEN];
@@ -661,8 +759,8 @@ ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
     if (!ucs_socket_is_connected(fd)) {
         ucs_warn("tcp_iface %p: connection establishment for socket fd %d "
                  "from %s to %s was unsuccessful", iface, fd,
-                 ucs_sockaddr_str((const struct sockaddr*)&peer_addr,
-                                  str_remote_addr, UCS_SOCKADDR_STRING_LEN),
+                 ucs_sockaddr_str(peer_addr, str_remote_addr,
+                                  UCS_SOCKADDR_STRING_LEN),
                  ucs_sockaddr_str((const struct sockaddr*)&iface->config.ifaddr,
                                   str_local_addr, UCS_SOCKADDR_STRING_LEN));
         return UCS_ERR_UNREACHABLE;
@@ -678,8 +776,8 @@ ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
 
     ucs_debug("tcp_iface %p: accepted connection from "
               "%s on %s to tcp_ep %p (fd %d)", iface,
-              ucs_sockaddr_str((const struct sockaddr*)peer_addr,
-                               str_remote_addr, UCS_SOCKADDR_STRING_LEN),
+              ucs_sockaddr_str(peer_addr, str_remote_addr,
+                               UCS_SOCKADDR_STRING_LEN),
               ucs_sockaddr_str((const struct sockaddr*)&iface->config.ifaddr,
                                str_local_addr, UCS_SOCKADDR_STRING_LEN),
               ep, fd);
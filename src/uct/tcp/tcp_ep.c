@@ -13,9 +13,15 @@
 
 
 /* Forward declarations */
+static unsigned uct_tcp_ep_msg_zcopy_dispatch(uct_tcp_ep_t *ep,
+                                              ucs_status_t status);
 static unsigned uct_tcp_ep_progress_data_tx(uct_tcp_ep_t *ep);
 static unsigned uct_tcp_ep_progress_data_rx(uct_tcp_ep_t *ep);
 static unsigned uct_tcp_ep_progress_magic_number_rx(uct_tcp_ep_t *ep);
+static void uct_tcp_ep_get_cancel(uct_tcp_ep_t *ep);
+static void uct_tcp_ep_get_purge(uct_tcp_ep_t *ep, ucs_status_t status);
+static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep,
+                                           ucs_status_t status);
 
 const uct_tcp_cm_state_t uct_tcp_ep_cm_state[] = {
     [UCT_TCP_EP_CONN_STATE_CLOSED] = {
@@ -64,6 +70,35 @@ static inline int uct_tcp_ep_ctx_buf_need_progress(uct_tcp_ep_ctx_t *ctx)
     return ctx->offset < ctx->length;
 }
 
+static int uct_tcp_ep_is_fenced(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_t *stream;
+    unsigned i;
+
+    if (ucs_likely(!(ep->flags & UCT_TCP_EP_FLAG_FENCE))) {
+        return 0;
+    }
+
+    for (i = 0; i < ep->streams.count; ++i) {
+        stream = ep->streams.eps[i];
+        if ((stream->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
+            (!uct_tcp_ep_ctx_buf_empty(&stream->tx) ||
+             (stream->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK))) {
+            return 1;
+        }
+    }
+
+    /* All PUT operations started on the streams before the fence were
+     * delivered to the peer */
+    ep->flags &= ~UCT_TCP_EP_FLAG_FENCE;
+    return 0;
+}
+
+static inline int uct_tcp_ep_is_tx_ready(uct_tcp_ep_t *ep)
+{
+    return uct_tcp_ep_ctx_buf_empty(&ep->tx) && !uct_tcp_ep_is_fenced(ep);
+}
+
 static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
 {
     if (ucs_unlikely(ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED)) {
@@ -77,7 +112,7 @@ static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
         return UCS_ERR_NO_RESOURCE;
     }
 
-    return uct_tcp_ep_ctx_buf_empty(&ep->tx) ? UCS_OK : UCS_ERR_NO_RESOURCE;
+    return uct_tcp_ep_is_tx_ready(ep) ? UCS_OK : UCS_ERR_NO_RESOURCE;
 }
 
 static inline void uct_tcp_ep_ctx_rewind(uct_tcp_ep_ctx_t *ctx)
@@ -143,6 +178,15 @@ static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
     ucs_close_fd(&ep->stale_fd);
 }
 
+static int uct_tcp_ep_is_unix_socket(int fd)
+{
+    int domain;
+
+    return (ucs_socket_getopt(fd, SOL_SOCKET, SO_DOMAIN, &domain,
+                              sizeof(domain)) == UCS_OK) &&
+           (domain == AF_UNIX);
+}
+
 static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface,
                            int fd, const struct sockaddr_in *dest_addr)
 {
@@ -161,13 +205,24 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface,
     self->conn_retries = 0;
     self->fd           = fd;
     self->stale_fd     = -1;
-    self->flags        = 0;
+    self->flags        = uct_tcp_ep_is_unix_socket(fd) ? UCT_TCP_EP_FLAG_UNIX : 0;
     self->conn_state   = UCT_TCP_EP_CONN_STATE_CLOSED;
     self->conn_sn      = UCT_TCP_CM_CONN_SN_MAX;
+    self->put_ack_sn   = UINT32_MAX;
+
+    self->msg_zcopy.sn           = 0;
+    self->msg_zcopy.completed_sn = UINT32_MAX;
+    self->get.sn                 = 0;
+    self->get.completed_sn       = 0;
+    self->streams.eps            = NULL;
+    self->streams.count          = 0;
 
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->msg_zcopy.queue);
+    ucs_queue_head_init(&self->get.ops);
+    ucs_queue_head_init(&self->get.resp_q);
 
     /* Make a socket non-blocking if an EP is created during accepting
      * a connection or non-blocking connection mode is requested */
@@ -178,7 +233,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface,
         }
     }
 
-    status = uct_tcp_iface_set_sockopt(iface, self->fd);
+    status = uct_tcp_iface_set_sockopt(iface, self->fd,
+                                       self->flags & UCT_TCP_EP_FLAG_UNIX);
     if (status != UCS_OK) {
         goto err_cleanup;
     }
@@ -195,7 +251,7 @@ err_cleanup:
     return status;
 }
 
-const char *uct_tcp_ep_ctx_caps_str(uint8_t ep_ctx_caps, char *str_buffer)
+const char *uct_tcp_ep_ctx_caps_str(uint16_t ep_ctx_caps, char *str_buffer)
 {
     ucs_snprintf_zero(str_buffer, UCT_TCP_EP_CTX_CAPS_STR_MAX, "[%s:%s]",
                       (ep_ctx_caps & UCT_TCP_EP_FLAG_CTX_TYPE_TX) ?
@@ -205,7 +261,7 @@ const char *uct_tcp_ep_ctx_caps_str(uint8_t ep_ctx_caps, char *str_buffer)
     return str_buffer;
 }
 
-void uct_tcp_ep_change_ctx_caps(uct_tcp_ep_t *ep, uint8_t new_caps)
+void uct_tcp_ep_change_ctx_caps(uct_tcp_ep_t *ep, uint16_t new_caps)
 {
     char str_prev_ctx_caps[UCT_TCP_EP_CTX_CAPS_STR_MAX];
     char str_cur_ctx_caps[UCT_TCP_EP_CTX_CAPS_STR_MAX];
@@ -218,20 +274,20 @@ void uct_tcp_ep_change_ctx_caps(uct_tcp_ep_t *ep, uint8_t new_caps)
     }
 }
 
-void uct_tcp_ep_add_ctx_cap(uct_tcp_ep_t *ep, uint8_t ctx_cap)
+void uct_tcp_ep_add_ctx_cap(uct_tcp_ep_t *ep, uint16_t ctx_cap)
 {
     ucs_assert(ctx_cap & UCT_TCP_EP_CTX_CAPS);
     uct_tcp_ep_change_ctx_caps(ep, ep->flags | ctx_cap);
 }
 
-void uct_tcp_ep_remove_ctx_cap(uct_tcp_ep_t *ep, uint8_t ctx_cap)
+void uct_tcp_ep_remove_ctx_cap(uct_tcp_ep_t *ep, uint16_t ctx_cap)
 {
     ucs_assert(ctx_cap & UCT_TCP_EP_CTX_CAPS);    
     uct_tcp_ep_change_ctx_caps(ep, ep->flags & ~ctx_cap);
 }
 
 void uct_tcp_ep_move_ctx_cap(uct_tcp_ep_t *from_ep, uct_tcp_ep_t *to_ep,
-                             uint8_t ctx_cap)
+                             uint16_t ctx_cap)
 {
     uct_tcp_ep_remove_ctx_cap(from_ep, ctx_cap);
     uct_tcp_ep_add_ctx_cap(to_ep, ctx_cap);
@@ -257,8 +313,12 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
         ucs_free(put_comp);
     }
 
+    uct_tcp_ep_msg_zcopy_dispatch(self, UCS_ERR_CANCELED);
+    uct_tcp_ep_get_purge(self, UCS_ERR_CANCELED);
+
     uct_tcp_cm_change_conn_state(self, UCT_TCP_EP_CONN_STATE_CLOSED);
     uct_tcp_ep_cleanup(self);
+    ucs_free(self->streams.eps);
 
     ucs_debug("tcp_ep %p: destroyed on iface %p", self, iface);
 }
@@ -276,6 +336,16 @@ void uct_tcp_ep_destroy(uct_ep_h tl_ep)
     uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
+    uct_tcp_ep_t *stream;
+
+    /* The streams are destroyed in the same way as the user's EP, i.e. they
+     * keep receiving data if the peer uses them as its own streams */
+    while (ep->streams.count > 0) {
+        stream = ep->streams.eps[--ep->streams.count];
+        ucs_assert(stream->flags & UCT_TCP_EP_FLAG_STREAM);
+        stream->flags &= ~UCT_TCP_EP_FLAG_STREAM;
+        uct_tcp_ep_destroy(&stream->super.super);
+    }
 
     if ((ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
         ucs_test_all_flags(ep->flags, UCT_TCP_EP_CTX_CAPS)) {
@@ -285,17 +355,60 @@ void uct_tcp_ep_destroy(uct_ep_h tl_ep)
         /* remove TX capability, but still will be able to receive data */
         uct_tcp_ep_remove_ctx_cap(ep, UCT_TCP_EP_FLAG_CTX_TYPE_TX);
         uct_tcp_cm_insert_ep(iface, ep);
+        uct_tcp_ep_get_cancel(ep);
     } else {
         uct_tcp_ep_destroy_internal(tl_ep);
     }
 }
 
+static void uct_tcp_ep_fail_streams(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *stream;
+
+    /* The streams are hidden from the user, so they can't outlive the user's
+     * EP. Fail their operations now, but destroy them from the iface progress,
+     * since events of the streams may be being dispatched at the moment */
+    while (ep->streams.count > 0) {
+        stream = ep->streams.eps[--ep->streams.count];
+        ucs_assert(stream->flags & UCT_TCP_EP_FLAG_STREAM);
+
+        if (stream->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED) {
+            uct_tcp_ep_handle_disconnected(stream, UCS_ERR_CANCELED);
+        }
+
+        if (stream->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX) {
+            uct_tcp_cm_remove_ep(iface, stream);
+        } else {
+            uct_tcp_iface_remove_ep(stream);
+        }
+
+        ucs_list_add_tail(&iface->stream_gc_list, &stream->list);
+        ucs_debug("tcp_ep %p: stream tcp_ep %p is released", ep, stream);
+    }
+}
+
 void uct_tcp_ep_set_failed(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
+    uct_tcp_ep_put_completion_t *put_comp;
 
     uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
+
+    if (ep->flags & UCT_TCP_EP_FLAG_STREAM) {
+        /* The stream is not used anymore, but the user's EP is still able
+         * to send data. Only flush operations which wait for PUT operations
+         * sent on the stream have to be failed */
+        ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem, 1) {
+            uct_invoke_completion(put_comp->comp, UCS_ERR_ENDPOINT_TIMEOUT);
+            ucs_free(put_comp);
+        }
+        return;
+    }
+
+    uct_tcp_ep_fail_streams(ep);
     uct_set_ep_failed(&UCS_CLASS_NAME(uct_tcp_ep_t),
                       &ep->super.super, &iface->super.super,
                       UCS_ERR_ENDPOINT_TIMEOUT);
@@ -314,7 +427,10 @@ uct_tcp_ep_create_socket_and_connect(uct_tcp_iface_t *iface,
     /* if EP is already allocated, dest_addr can be NULL */
     ucs_assert((*ep_p != NULL) || (dest_addr != NULL));
 
-    status = ucs_socket_create(AF_INET, SOCK_STREAM, &fd);
+    /* Try to connect through a Unix domain socket first, connection start
+     * falls back to TCP if the peer is not on the same host */
+    status = ucs_socket_create(iface->config.unix_enable ? AF_UNIX : AF_INET,
+                               SOCK_STREAM, &fd);
     if (status != UCS_OK) {
         goto err;
     }
@@ -333,6 +449,18 @@ uct_tcp_ep_create_socket_and_connect(uct_tcp_iface_t *iface,
     } else {
         ep     = *ep_p;
         ep->fd = fd;
+
+        if (uct_tcp_ep_is_unix_socket(fd)) {
+            ep->flags |= UCT_TCP_EP_FLAG_UNIX;
+        } else {
+            ep->flags &= ~UCT_TCP_EP_FLAG_UNIX;
+        }
+
+        status = uct_tcp_iface_set_sockopt(iface, ep->fd,
+                                           ep->flags & UCT_TCP_EP_FLAG_UNIX);
+        if (status != UCS_OK) {
+            goto err_ep_destroy;
+        }
     }
 
     status = uct_tcp_cm_conn_start(ep);
@@ -379,30 +507,21 @@ static ucs_status_t uct_tcp_ep_create_connected(uct_tcp_iface_t *iface,
     return UCS_OK;
 }
 
-ucs_status_t uct_tcp_ep_create(const uct_ep_params_t *params,
-                               uct_ep_h *ep_p)
+static ucs_status_t uct_tcp_ep_create_to_peer(uct_tcp_iface_t *iface,
+                                              const struct sockaddr_in *dest_addr,
+                                              uct_tcp_ep_t **ep_p)
 {
-    uct_tcp_iface_t *iface = ucs_derived_of(params->iface, uct_tcp_iface_t);
-    uct_tcp_ep_t *ep       = NULL;
-    struct sockaddr_in dest_addr;
+    uct_tcp_ep_t *ep = NULL;
     uct_tcp_cm_conn_sn_t conn_sn;
     ucs_status_t status;
 
-    UCT_EP_PARAMS_CHECK_DEV_IFACE_ADDRS(params);
-    memset(&dest_addr, 0, sizeof(dest_addr));
-    /* TODO: handle AF_INET6 */
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port   = *(in_port_t*)params->iface_addr;
-    dest_addr.sin_addr   = *(const struct in_addr*)ucs_sockaddr_get_inet_addr
-                                                   ((struct sockaddr*)params->dev_addr);
-
-    conn_sn = uct_tcp_cm_get_conn_sn(iface, &dest_addr);
+    conn_sn = uct_tcp_cm_get_conn_sn(iface, dest_addr);
 
-    if (uct_tcp_iface_is_self_addr(iface, &dest_addr)) {
+    if (uct_tcp_iface_is_self_addr(iface, dest_addr)) {
         goto out_create_ep;
     }
 
-    ep = uct_tcp_cm_get_ep(iface, &dest_addr, conn_sn,
+    ep = uct_tcp_cm_get_ep(iface, dest_addr, conn_sn,
                            UCT_TCP_EP_FLAG_CTX_TYPE_RX);
     if (ep == NULL) {
         goto out_create_ep;
@@ -425,12 +544,74 @@ ucs_status_t uct_tcp_ep_create(const uct_ep_params_t *params,
 
 out_create_ep:
     if (ep == NULL) {
-        status = uct_tcp_ep_create_connected(iface, &dest_addr, conn_sn, &ep);
+        status = uct_tcp_ep_create_connected(iface, dest_addr, conn_sn, &ep);
         if (status != UCS_OK) {
             return status;
         }
     }
 
+    *ep_p = ep;
+    return UCS_OK;
+}
+
+static void uct_tcp_ep_create_streams(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                                      const struct sockaddr_in *dest_addr)
+{
+    unsigned num_streams = iface->config.num_streams - 1;
+    uct_tcp_ep_t *stream;
+    ucs_status_t status;
+
+    if ((num_streams == 0) || uct_tcp_iface_is_self_addr(iface, dest_addr)) {
+        return;
+    }
+
+    ep->streams.eps = ucs_calloc(num_streams, sizeof(*ep->streams.eps),
+                                 "tcp_ep_streams");
+    if (ep->streams.eps == NULL) {
+        ucs_diag("tcp_ep %p: failed to allocate %u streams, using single "
+                 "socket", ep, num_streams);
+        return;
+    }
+
+    while (ep->streams.count < num_streams) {
+        status = uct_tcp_ep_create_to_peer(iface, dest_addr, &stream);
+        if (status != UCS_OK) {
+            /* Continue with a lower number of streams */
+            ucs_diag("tcp_ep %p: failed to create stream #%u: %s", ep,
+                     ep->streams.count + 1, ucs_status_string(status));
+            break;
+        }
+
+        stream->flags |= UCT_TCP_EP_FLAG_STREAM;
+        ep->streams.eps[ep->streams.count++] = stream;
+        ucs_debug("tcp_ep %p: created stream #%u tcp_ep %p", ep,
+                  ep->streams.count, stream);
+    }
+}
+
+ucs_status_t uct_tcp_ep_create(const uct_ep_params_t *params,
+                               uct_ep_h *ep_p)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(params->iface, uct_tcp_iface_t);
+    uct_tcp_ep_t *ep;
+    struct sockaddr_in dest_addr;
+    ucs_status_t status;
+
+    UCT_EP_PARAMS_CHECK_DEV_IFACE_ADDRS(params);
+    memset(&dest_addr, 0, sizeof(dest_addr));
+    /* TODO: handle AF_INET6 */
+    dest_addr.sin_family = AF_INET;
+    dest_addr.sin_port   = *(in_port_t*)params->iface_addr;
+    dest_addr.sin_addr   = *(const struct in_addr*)ucs_sockaddr_get_inet_addr
+                                                   ((struct sockaddr*)params->dev_addr);
+
+    status = uct_tcp_ep_create_to_peer(iface, &dest_addr, &ep);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    uct_tcp_ep_create_streams(iface, ep, &dest_addr);
+
     /* cppcheck-suppress autoVariables */
     *ep_p = &ep->super.super;
     return UCS_OK;
@@ -467,12 +648,36 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, int add, int rem)
     }
 }
 
+static UCS_F_ALWAYS_INLINE int
+uct_tcp_ep_put_comp_is_done(uct_tcp_ep_t *ep,
+                            const uct_tcp_ep_put_completion_t *put_comp)
+{
+    return UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn, <=, ep->put_ack_sn) &&
+           (ucs_queue_is_empty(&ep->msg_zcopy.queue) ||
+            UCS_CIRCULAR_COMPARE32(put_comp->wait_msg_zcopy_sn, <=,
+                                   ep->msg_zcopy.completed_sn)) &&
+           UCS_CIRCULAR_COMPARE32(put_comp->wait_get_sn, <=,
+                                  ep->get.completed_sn);
+}
+
+static void uct_tcp_ep_put_comp_progress(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_put_completion_t *put_comp;
+
+    ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem,
+                               uct_tcp_ep_put_comp_is_done(ep, put_comp)) {
+        uct_invoke_completion(put_comp->comp, UCS_OK);
+        ucs_free(put_comp);
+    }
+}
+
 static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
                                              uct_tcp_ep_put_ack_hdr_t *put_ack)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
-    uct_tcp_ep_put_completion_t *put_comp;
+
+    ep->put_ack_sn = put_ack->sn;
 
     if (put_ack->sn == ep->tx.put_sn) {
         /* Since there are no other PUT operations in-flight, can remove flag
@@ -482,11 +687,61 @@ static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
         uct_tcp_iface_outstanding_dec(iface);
     }
 
-    ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem,
-                               (UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn,
-                                                       <=, put_ack->sn))) {
-        uct_invoke_completion(put_comp->comp, UCS_OK);
-        ucs_free(put_comp);
+    uct_tcp_ep_put_comp_progress(ep);
+}
+
+static void uct_tcp_ep_get_op_completed(uct_tcp_ep_t *ep,
+                                        uct_tcp_ep_get_op_t *op,
+                                        ucs_status_t status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    ep->get.completed_sn++;
+
+    /* Canceled operations were already completed */
+    if (op->iov_cnt != 0) {
+        uct_tcp_iface_outstanding_dec(iface);
+        if (op->comp != NULL) {
+            uct_invoke_completion(op->comp, status);
+        }
+    }
+
+    ucs_mpool_put_inline(op);
+}
+
+static void uct_tcp_ep_get_cancel(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *op;
+
+    /* The responses will still arrive from the peer, so keep the operations
+     * to drop the data, but don't write it to the user's buffers anymore */
+    ucs_queue_for_each(op, &ep->get.ops, queue) {
+        if (op->iov_cnt != 0) {
+            op->iov_cnt = 0;
+            uct_tcp_iface_outstanding_dec(iface);
+            if (op->comp != NULL) {
+                uct_invoke_completion(op->comp, UCS_ERR_CANCELED);
+            }
+        }
+    }
+}
+
+static void uct_tcp_ep_get_purge(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_ep_get_resp_t *resp;
+    uct_tcp_ep_get_op_t *op;
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+
+    ucs_queue_for_each_extract(op, &ep->get.ops, queue, 1) {
+        uct_tcp_ep_get_op_completed(ep, op, status);
+    }
+
+    ucs_queue_for_each_extract(resp, &ep->get.resp_q, queue, 1) {
+        ucs_free(resp);
     }
 }
 
@@ -495,8 +750,8 @@ void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep)
     uct_pending_req_priv_queue_t *priv;
 
     uct_pending_queue_dispatch(priv, &ep->pending_q,
-                               uct_tcp_ep_ctx_buf_empty(&ep->tx));
-    if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
+                               uct_tcp_ep_is_tx_ready(ep));
+    if (uct_tcp_ep_is_tx_ready(ep)) {
         ucs_assert(ucs_queue_is_empty(&ep->pending_q));
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
     }
@@ -526,12 +781,134 @@ static UCS_F_ALWAYS_INLINE void
 uct_tcp_ep_zcopy_completed(uct_tcp_ep_t *ep, uct_completion_t *comp,
                            ucs_status_t status)
 {
-    ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_TX;
+    ep->flags &= ~(UCT_TCP_EP_FLAG_ZCOPY_TX | UCT_TCP_EP_FLAG_MSG_ZCOPY_TX);
     if (comp != NULL) {
         uct_invoke_completion(comp, status);
     }
 }
 
+static unsigned uct_tcp_ep_msg_zcopy_dispatch(uct_tcp_ep_t *ep,
+                                              ucs_status_t status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned count         = 0;
+    uct_tcp_ep_zcopy_tx_t *ctx;
+
+    /* Complete Zcopy operations which are notified by the kernel, or all of
+     * them if the EP is failed or being destroyed. The TX buffer keeps TCP AM
+     * and user's headers referenced by the kernel, so release it only now */
+    ucs_queue_for_each_extract(ctx, &ep->msg_zcopy.queue, queue,
+                               (status != UCS_OK) ||
+                               UCS_CIRCULAR_COMPARE32(ctx->msg_zcopy_sn, <=,
+                                                      ep->msg_zcopy.completed_sn)) {
+        if (ctx->comp != NULL) {
+            uct_invoke_completion(ctx->comp, status);
+        }
+
+        ucs_mpool_put_inline(ctx);
+        uct_tcp_iface_outstanding_dec(iface);
+        ++count;
+    }
+
+    if ((count > 0) && (status == UCS_OK)) {
+        uct_tcp_ep_put_comp_progress(ep);
+    }
+
+    return count;
+}
+
+static void uct_tcp_ep_msg_zcopy_tx_completed(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface     = ucs_derived_of(ep->super.super.iface,
+                                                uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
+    /* UCS_INPROGRESS was already returned to the user */
+    int in_progress            = ep->flags & UCT_TCP_EP_FLAG_ZCOPY_TX;
+
+    ep->flags &= ~(UCT_TCP_EP_FLAG_ZCOPY_TX | UCT_TCP_EP_FLAG_MSG_ZCOPY_TX);
+    ep->tx.buf = NULL;
+    uct_tcp_ep_ctx_rewind(&ep->tx);
+
+    if (ucs_queue_is_empty(&ep->msg_zcopy.queue) &&
+        UCS_CIRCULAR_COMPARE32(ctx->msg_zcopy_sn, <=,
+                               ep->msg_zcopy.completed_sn)) {
+        /* Nothing was sent with MSG_ZEROCOPY or the kernel already released
+         * all buffers of the operation */
+        if (in_progress && (ctx->comp != NULL)) {
+            uct_invoke_completion(ctx->comp, UCS_OK);
+        }
+
+        ucs_mpool_put_inline(ctx);
+        return;
+    }
+
+    /* All data was passed to the kernel, but the completion is reported
+     * only after the kernel releases the buffers. Detach the TX buffer
+     * from the EP to be able to post the next operation meanwhile */
+    ucs_queue_push(&ep->msg_zcopy.queue, &ctx->queue);
+    uct_tcp_iface_outstanding_inc(iface);
+}
+
+unsigned uct_tcp_ep_progress_msg_zcopy(uct_tcp_ep_t *ep)
+{
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    char cmsg_buf[CMSG_SPACE(sizeof(struct sock_extended_err) +
+                             sizeof(struct sockaddr_in6))];
+    struct sock_extended_err *serr;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    int ret;
+
+    for (;;) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+
+        ret = recvmsg(ep->fd, &msg, MSG_ERRQUEUE);
+        if (ret < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) &&
+                (errno != EINTR)) {
+                ucs_error("tcp_ep %p: recvmsg(fd=%d, MSG_ERRQUEUE) failed: %m",
+                          ep, ep->fd);
+            }
+            break;
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (!(((cmsg->cmsg_level == SOL_IP) &&
+                   (cmsg->cmsg_type == IP_RECVERR)) ||
+                  ((cmsg->cmsg_level == SOL_IPV6) &&
+                   (cmsg->cmsg_type == IPV6_RECVERR)))) {
+                continue;
+            }
+
+            serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if ((serr->ee_errno != 0) ||
+                (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)) {
+                continue;
+            }
+
+            /* Notification reports [ee_info, ee_data] range of completed
+             * sends, TCP reports the ranges in order of sending */
+            ucs_trace_data("tcp_ep %p: MSG_ZEROCOPY notification [%u..%u]%s",
+                           ep, serr->ee_info, serr->ee_data,
+                           (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) ?
+                           " copied" : "");
+            if (UCS_CIRCULAR_COMPARE32(serr->ee_data, >,
+                                       ep->msg_zcopy.completed_sn)) {
+                ep->msg_zcopy.completed_sn = serr->ee_data;
+            }
+        }
+    }
+
+    return uct_tcp_ep_msg_zcopy_dispatch(ep, UCS_OK);
+#else
+    return 0;
+#endif
+}
+
 static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -556,6 +933,10 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status
             uct_tcp_ep_zcopy_completed(ep, ctx->comp, status);
         }
 
+        /* Notifications for MSG_ZEROCOPY sends will never arrive */
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+        uct_tcp_ep_msg_zcopy_dispatch(ep, status);
+
         if (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
             /* if the EP is waiting for the acknowledgment of the started
              * PUT operation, decrease iface::outstanding counter */
@@ -563,6 +944,9 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status
             ep->flags &= ~UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
         }
 
+        /* Responses for GET operations will never arrive */
+        uct_tcp_ep_get_purge(ep, status);
+
         uct_tcp_ep_tx_completed(ep, ep->tx.length - ep->tx.offset);
         uct_tcp_ep_set_failed(ep);
     } else {
@@ -593,6 +977,36 @@ static inline ssize_t uct_tcp_ep_send(uct_tcp_ep_t *ep)
     return sent_length;
 }
 
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_do_sendv(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                    size_t *sent_length_p)
+{
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    uct_tcp_ep_zcopy_tx_t *ctx;
+    ucs_status_t status;
+
+    if (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) {
+        status = ucs_socket_sendmsg_nb(ep->fd, iov, iov_cnt, MSG_ZEROCOPY,
+                                       sent_length_p);
+        if (ucs_likely(status == UCS_OK)) {
+            /* Each successful MSG_ZEROCOPY send consumes notification ID */
+            ctx               = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
+            ctx->msg_zcopy_sn = ep->msg_zcopy.sn++;
+            return UCS_OK;
+        } else if (status != UCS_ERR_NO_MEMORY) {
+            return status;
+        }
+
+        /* The kernel is unable to pin the pages (optmem or locked memory
+         * limits are reached), fall back to copying send */
+        ucs_trace_data("tcp_ep %p: MSG_ZEROCOPY send failed, fallback to "
+                       "copy", ep);
+    }
+#endif
+
+    return ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, sent_length_p);
+}
+
 static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
 {
     uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
@@ -602,7 +1016,7 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     ucs_assertv((ep->tx.offset < ep->tx.length) &&
                 (ctx->iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
+    status = uct_tcp_ep_do_sendv(ep, &ctx->iov[ctx->iov_index],
                                  ctx->iov_cnt - ctx->iov_index, &sent_length);
     if (ucs_unlikely(status != UCS_OK)) {
         if (status == UCS_ERR_NO_PROGRESS) {
@@ -619,7 +1033,7 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     if (ep->tx.offset != ep->tx.length) {
         ucs_iov_advance(ctx->iov, ctx->iov_cnt,
                         &ctx->iov_index, sent_length);
-    } else {
+    } else if (!(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX)) {
         uct_tcp_ep_zcopy_completed(ep, ctx->comp, UCS_OK);
     }
 
@@ -737,11 +1151,13 @@ static inline void uct_tcp_ep_handle_recv_err(uct_tcp_ep_t *ep,
         /* If no data were read to the allocated buffer,
          * we can safely reset it for futher re-use and to
          * avoid overwriting this buffer, because `rx::length == 0` */
-        if (ep->rx.length == 0) {
+        if ((ep->rx.length == 0) && (ep->rx.buf != NULL)) {
             uct_tcp_ep_ctx_reset(&ep->rx);
         }
     } else {
-        uct_tcp_ep_ctx_reset(&ep->rx);
+        if (ep->rx.buf != NULL) {
+            uct_tcp_ep_ctx_reset(&ep->rx);
+        }
         uct_tcp_ep_handle_disconnected(ep, status);
     }
 }
@@ -792,7 +1208,11 @@ static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
 static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
 {
     if (ucs_likely(!uct_tcp_ep_ctx_buf_need_progress(&ep->tx))) {
-        uct_tcp_ep_ctx_reset(&ep->tx);
+        if (ucs_unlikely(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX)) {
+            uct_tcp_ep_msg_zcopy_tx_completed(ep);
+        } else {
+            uct_tcp_ep_ctx_reset(&ep->tx);
+        }
     } else {
         uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
     }
@@ -801,6 +1221,7 @@ static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
 /* Forward declaration - the function depends on AM send
  * functions implemented below */
 static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep);
+static ucs_status_t uct_tcp_ep_progress_get_resp(uct_tcp_ep_t *ep);
 
 static unsigned uct_tcp_ep_progress_data_tx(uct_tcp_ep_t *ep)
 {
@@ -829,12 +1250,18 @@ static unsigned uct_tcp_ep_progress_data_tx(uct_tcp_ep_t *ep)
         uct_tcp_ep_post_put_ack(ep);
     }
 
+    if (!ucs_queue_is_empty(&ep->get.resp_q) &&
+        (uct_tcp_ep_progress_get_resp(ep) != UCS_OK)) {
+        /* The EP was failed and could be destroyed */
+        return 1;
+    }
+
     if (!ucs_queue_is_empty(&ep->pending_q)) {
         uct_tcp_ep_pending_queue_dispatch(ep);
         return ret;
     }
 
-    if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
+    if (uct_tcp_ep_is_tx_ready(ep)) {
         ucs_assert(ucs_queue_is_empty(&ep->pending_q));
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
     }
@@ -913,52 +1340,173 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
-static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+static int uct_tcp_ep_get_rx_advance(uct_tcp_ep_t *ep, size_t recv_length)
 {
-    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
-                                            uct_tcp_iface_t);
-    unsigned handled       = 0;
-    uct_tcp_am_hdr_t *hdr;
-    size_t recv_length;
-    size_t remaining;
+    uct_tcp_ep_get_op_t *op = ucs_queue_head_elem_non_empty(&ep->get.ops,
+                                                            uct_tcp_ep_get_op_t,
+                                                            queue);
 
-    ucs_trace_func("ep=%p", ep);
+    ucs_assert(recv_length <= op->length);
+    op->length -= recv_length;
 
-    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        ucs_assert(ep->rx.buf == NULL);
-        ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
-        if (ucs_unlikely(ep->rx.buf == NULL)) {
-            ucs_warn("tcp_ep %p: unable to get a buffer from RX memory pool", ep);
-            return 0;
+    if (op->length != 0) {
+        if (op->iov_cnt != 0) {
+            ucs_iov_advance(op->iov, op->iov_cnt, &op->iov_index, recv_length);
+        }
+        return 0;
+    }
+
+    ucs_queue_pull_non_empty(&ep->get.ops);
+
+    /* EP's flags don't have UCT_TCP_EP_FLAG_GET_RX flag set in case of
+     * entire GET response was received through AM protocol */
+    if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        /* RX buffer is used only to drop the data of canceled operations */
+        if (ep->rx.buf != NULL) {
+            uct_tcp_ep_ctx_reset(&ep->rx);
         }
+    }
 
-        /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
-    } else if (ep->rx.length < sizeof(*hdr)) {
-        ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
+    uct_tcp_ep_get_op_completed(ep, op, UCS_OK);
+    uct_tcp_ep_put_comp_progress(ep);
+    return 1;
+}
 
-        /* do partial receive of the remaining part of the hdr
-         * and post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size - ep->rx.length;
-    } else {
-        ucs_assert((ep->rx.buf != NULL) &&
-                   ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
+static inline ucs_status_t
+uct_tcp_ep_handle_get_resp(uct_tcp_ep_t *ep,
+                           const uct_tcp_ep_get_resp_hdr_t *get_resp,
+                           size_t extra_recvd_length)
+{
+    uct_tcp_ep_get_op_t *op;
+    size_t copied_length;
 
-        /* do partial receive of the remaining user data */
-        hdr         = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
-        recv_length = hdr->length - (ep->rx.length - ep->rx.offset - sizeof(*hdr));
+    if (ucs_unlikely(ucs_queue_is_empty(&ep->get.ops))) {
+        ucs_error("tcp_ep %p: received GET response (length %zu status %d) "
+                  "while no GET operation is in progress", ep,
+                  get_resp->length, get_resp->status);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    op = ucs_queue_head_elem_non_empty(&ep->get.ops, uct_tcp_ep_get_op_t,
+                                       queue);
+
+    if (ucs_unlikely(get_resp->status != UCS_OK)) {
+        /* The peer was unable to read the requested data, only the header
+         * was sent */
+        ucs_debug("tcp_ep %p: GET operation of %zu bytes failed on the peer: "
+                  "%s", ep, op->length,
+                  ucs_status_string((ucs_status_t)get_resp->status));
+        ucs_queue_pull_non_empty(&ep->get.ops);
+        uct_tcp_ep_get_op_completed(ep, op, (ucs_status_t)get_resp->status);
+        uct_tcp_ep_put_comp_progress(ep);
+        return UCS_OK;
     }
 
-    if (!uct_tcp_ep_recv(ep, recv_length)) {
-        goto out;
+    if (ucs_unlikely(get_resp->length != op->length)) {
+        ucs_error("tcp_ep %p: received GET response of %zu bytes, while %zu "
+                  "bytes were requested", ep, get_resp->length, op->length);
+        return UCS_ERR_IO_ERROR;
     }
 
-    /* Parse received active messages */
-    while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        remaining = ep->rx.length - ep->rx.offset;
-        if (remaining < sizeof(*hdr)) {
-            /* Move the partially received hdr to the beginning of the buffer */
-            memmove(ep->rx.buf, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+    copied_length = ucs_min(op->length, extra_recvd_length);
+    if (op->iov_cnt != 0) {
+        ucs_iov_copy(op->iov, op->iov_cnt, 0,
+                     UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+                     copied_length, UCS_IOV_COPY_FROM_BUF);
+    }
+    ep->rx.offset += copied_length;
+
+    if (uct_tcp_ep_get_rx_advance(ep, copied_length)) {
+        return UCS_OK;
+    }
+
+    /* The rest of the response is received directly to the user's buffers,
+     * so the RX buffer can be released */
+    ucs_assert(ep->rx.offset == ep->rx.length);
+    uct_tcp_ep_ctx_reset(&ep->rx);
+    ep->flags |= UCT_TCP_EP_FLAG_GET_RX;
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_tcp_ep_handle_get_req(uct_tcp_ep_t *ep,
+                          const uct_tcp_ep_get_req_hdr_t *get_req)
+{
+    uct_tcp_ep_get_resp_t *resp;
+
+    resp = ucs_malloc(sizeof(*resp), "tcp_get_resp");
+    if (ucs_unlikely(resp == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET response", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    /* The response is sent from TX progress in the order of the requests,
+     * since the peer matches the responses with its GET operations */
+    resp->req = *get_req;
+    ucs_queue_push(&ep->get.resp_q, &resp->queue);
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+    return UCS_OK;
+}
+
+static void uct_tcp_ep_handle_rx_err(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    /* The received data can't be parsed anymore, since the EP is failed and
+     * could be destroyed */
+    if (ep->rx.buf != NULL) {
+        uct_tcp_ep_ctx_reset(&ep->rx);
+    }
+
+    uct_tcp_ep_handle_disconnected(ep, status);
+}
+
+static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned handled       = 0;
+    uct_tcp_am_hdr_t *hdr;
+    size_t recv_length;
+    size_t remaining;
+    ucs_status_t status;
+
+    ucs_trace_func("ep=%p", ep);
+
+    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        ucs_assert(ep->rx.buf == NULL);
+        ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
+        if (ucs_unlikely(ep->rx.buf == NULL)) {
+            ucs_warn("tcp_ep %p: unable to get a buffer from RX memory pool", ep);
+            return 0;
+        }
+
+        /* post the entire AM buffer */
+        recv_length = iface->config.rx_seg_size;
+    } else if (ep->rx.length < sizeof(*hdr)) {
+        ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
+
+        /* do partial receive of the remaining part of the hdr
+         * and post the entire AM buffer */
+        recv_length = iface->config.rx_seg_size - ep->rx.length;
+    } else {
+        ucs_assert((ep->rx.buf != NULL) &&
+                   ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
+
+        /* do partial receive of the remaining user data */
+        hdr         = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
+        recv_length = hdr->length - (ep->rx.length - ep->rx.offset - sizeof(*hdr));
+    }
+
+    if (!uct_tcp_ep_recv(ep, recv_length)) {
+        goto out;
+    }
+
+    /* Parse received active messages */
+    while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        remaining = ep->rx.length - ep->rx.offset;
+        if (remaining < sizeof(*hdr)) {
+            /* Move the partially received hdr to the beginning of the buffer */
+            memmove(ep->rx.buf, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
                     remaining);
             ep->rx.offset = 0;
             ep->rx.length = remaining;
@@ -999,6 +1547,31 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
             ucs_assert(hdr->length == sizeof(uint32_t));
             uct_tcp_ep_handle_put_ack(ep, (uct_tcp_ep_put_ack_hdr_t*)(hdr + 1));
             handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_req_hdr_t));
+            status = uct_tcp_ep_handle_get_req(ep,
+                                               (uct_tcp_ep_get_req_hdr_t*)
+                                               (hdr + 1));
+            handled++;
+            if (ucs_unlikely(status != UCS_OK)) {
+                uct_tcp_ep_handle_rx_err(ep, status);
+                goto out;
+            }
+        } else if (hdr->am_id == UCT_TCP_EP_GET_RESP_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_resp_hdr_t));
+            status = uct_tcp_ep_handle_get_resp(ep,
+                                                (uct_tcp_ep_get_resp_hdr_t*)
+                                                (hdr + 1),
+                                                ep->rx.length - ep->rx.offset);
+            handled++;
+            if (ucs_unlikely(status != UCS_OK)) {
+                uct_tcp_ep_handle_rx_err(ep, status);
+                goto out;
+            } else if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+                /* GET response is being received to the user's buffers and
+                 * EP RX buffer was already released */
+                goto out;
+            }
         } else {
             ucs_assert(hdr->am_id == UCT_TCP_EP_CM_AM_ID);
             handled += 1 + uct_tcp_cm_handle_conn_pkt(&ep, hdr + 1, hdr->length);
@@ -1073,12 +1646,59 @@ static unsigned uct_tcp_ep_progress_put_rx(uct_tcp_ep_t *ep)
     return 1;
 }
 
+static unsigned uct_tcp_ep_progress_get_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface  = ucs_derived_of(ep->super.super.iface,
+                                             uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *op = ucs_queue_head_elem_non_empty(&ep->get.ops,
+                                                            uct_tcp_ep_get_op_t,
+                                                            queue);
+    size_t recv_length;
+    ucs_status_t status;
+
+    if (ucs_likely(op->iov_cnt != 0)) {
+        status = ucs_socket_recvv_nb(ep->fd, &op->iov[op->iov_index],
+                                     op->iov_cnt - op->iov_index,
+                                     &recv_length);
+    } else {
+        /* The operation was canceled, drop the data */
+        if (ep->rx.buf == NULL) {
+            ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
+            if (ucs_unlikely(ep->rx.buf == NULL)) {
+                ucs_warn("tcp_ep %p: unable to get a buffer from RX memory "
+                         "pool", ep);
+                return 0;
+            }
+        }
+
+        recv_length = ucs_min(op->length, iface->config.rx_seg_size);
+        status      = ucs_socket_recv_nb(ep->fd, ep->rx.buf, &recv_length);
+    }
+
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            uct_tcp_ep_handle_recv_err(ep, status);
+        }
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+    ucs_trace_data("tcp_ep %p: recvd %zu bytes of GET response", ep,
+                   recv_length);
+
+    uct_tcp_ep_get_rx_advance(ep, recv_length);
+
+    return 1;
+}
+
 static unsigned uct_tcp_ep_progress_data_rx(uct_tcp_ep_t *ep)
 {
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
+    if (!(ep->flags & (UCT_TCP_EP_FLAG_PUT_RX | UCT_TCP_EP_FLAG_GET_RX))) {
         return uct_tcp_ep_progress_am_rx(ep);
-    } else {
+    } else if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
         return uct_tcp_ep_progress_put_rx(ep);
+    } else {
+        return uct_tcp_ep_progress_get_rx(ep);
     }
 }
 
@@ -1146,6 +1766,8 @@ uct_tcp_ep_set_outstanding_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_ZCOPY_TX;
 
     if ((header_length != 0) &&
+        /* the header is already in the TX buffer for MSG_ZEROCOPY sends */
+        !(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) &&
         /* check whether a user's header was sent or not */
         (ep->tx.offset < (sizeof(uct_tcp_am_hdr_t) + header_length))) {
         ucs_assert(header_length <= iface->config.zcopy.max_hdr);
@@ -1218,7 +1840,7 @@ uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
     ucs_assertv((ep->tx.length <= send_limit) &&
                 (iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    status = uct_tcp_ep_do_sendv(ep, iov, iov_cnt, &sent_length);
     if (ucs_unlikely((status != UCS_OK) && (status != UCS_ERR_NO_PROGRESS))) {
         uct_tcp_ep_handle_send_err(ep, status);
         return status;
@@ -1390,12 +2012,13 @@ ssize_t uct_tcp_ep_am_bcopy(uct_ep_h uct_ep, uint8_t am_id,
 static inline ucs_status_t
 uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id,
                          const void *header, unsigned header_length,
-                         const uct_iov_t *iov, size_t iovcnt, const char *name,
-                         size_t *zcopy_payload_p, uct_tcp_ep_zcopy_tx_t **ctx_p)
+                         const uct_iov_t *iov, size_t iovcnt,
+                         ucs_iov_iter_t *uct_iov_iter_p, size_t max_length,
+                         const char *name, size_t *zcopy_payload_p,
+                         uct_tcp_ep_zcopy_tx_t **ctx_p)
 {
     uct_tcp_am_hdr_t *hdr = NULL;
     size_t io_vec_cnt;
-    ucs_iov_iter_t uct_iov_iter;
     uct_tcp_ep_zcopy_tx_t *ctx;
     ucs_status_t status;
 
@@ -1426,16 +2049,176 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
     }
 
     /* User-defined payload */
-    ucs_iov_iter_init(&uct_iov_iter);
-    io_vec_cnt       = iovcnt; 
+    io_vec_cnt       = iovcnt;
     *zcopy_payload_p = uct_iov_to_iovec(&ctx->iov[ctx->iov_cnt], &io_vec_cnt,
-                                        iov, iovcnt, SIZE_MAX, &uct_iov_iter);
+                                        iov, iovcnt, max_length,
+                                        uct_iov_iter_p);
     *ctx_p           = ctx;
     ctx->iov_cnt    += io_vec_cnt;
 
     return UCS_OK;
 }
 
+static ucs_status_t
+uct_tcp_ep_check_get_req(uct_tcp_ep_t *ep,
+                         const uct_tcp_ep_get_req_hdr_t *get_req)
+{
+    ucs_status_t status;
+
+    if (get_req->length > (UCT_TCP_EP_PUT_ZCOPY_MAX -
+                           UCT_TCP_EP_GET_SERVICE_LENGTH)) {
+        status = UCS_ERR_INVALID_PARAM;
+    } else {
+        /* Reading from an invalid address would fail the send operation in
+         * the middle of the response and the connection would be lost */
+        status = ucs_sys_check_mem_readable((void*)(uintptr_t)get_req->addr,
+                                            get_req->length);
+        if (status == UCS_ERR_UNSUPPORTED) {
+            return UCS_OK;
+        }
+    }
+
+    if (status != UCS_OK) {
+        ucs_diag("tcp_ep %p: rejecting GET request of %zu bytes from address "
+                 "0x%"PRIx64": %s", ep, get_req->length, get_req->addr,
+                 ucs_status_string(status));
+    }
+
+    return status;
+}
+
+static ucs_status_t
+uct_tcp_ep_post_get_err_resp(uct_tcp_ep_t *ep, ucs_status_t resp_status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_get_resp_hdr_t *get_resp;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_RESP_AM_ID, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    hdr->length      = sizeof(*get_resp);
+    get_resp         = (uct_tcp_ep_get_resp_hdr_t*)(hdr + 1);
+    get_resp->length = 0;
+    get_resp->status = resp_status;
+
+    return uct_tcp_ep_am_send(ep, hdr);
+}
+
+static ucs_status_t
+uct_tcp_ep_post_get_resp(uct_tcp_ep_t *ep,
+                         const uct_tcp_ep_get_req_hdr_t *get_req)
+{
+    uct_tcp_iface_t *iface             = ucs_derived_of(ep->super.super.iface,
+                                                        uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx         = NULL;
+    uct_tcp_ep_get_resp_hdr_t get_resp = {0};
+    ucs_iov_iter_t uct_iov_iter;
+    uct_iov_t iov;
+    ucs_status_t status;
+
+    /* Don't check the request again if the response can't be sent now */
+    status = uct_tcp_ep_check_tx_res(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    status = uct_tcp_ep_check_get_req(ep, get_req);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return uct_tcp_ep_post_get_err_resp(ep, status);
+    }
+
+    /* Send the requested data directly from the memory of this process */
+    iov.buffer = (void*)(uintptr_t)get_req->addr;
+    iov.length = get_req->length;
+    iov.memh   = UCT_MEM_HANDLE_NULL;
+    iov.stride = 0;
+    iov.count  = 1;
+
+    ucs_iov_iter_init(&uct_iov_iter);
+    status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_GET_RESP_AM_ID,
+                                      &get_resp, sizeof(get_resp), &iov, 1,
+                                      &uct_iov_iter, SIZE_MAX, "get_zcopy",
+                                      &ep->tx.length, &ctx);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    ctx->super.length = sizeof(get_resp);
+    get_resp.length   = ep->tx.length;
+
+    status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
+                                 &get_resp, ctx->iov, ctx->iov_cnt);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+        uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &get_resp,
+                                         sizeof(get_resp), NULL);
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t uct_tcp_ep_progress_get_resp(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_get_resp_t *resp;
+    ucs_status_t status;
+
+    while (!ucs_queue_is_empty(&ep->get.resp_q)) {
+        resp   = ucs_queue_head_elem_non_empty(&ep->get.resp_q,
+                                               uct_tcp_ep_get_resp_t, queue);
+        status = uct_tcp_ep_post_get_resp(ep, &resp->req);
+        if (status == UCS_ERR_NO_RESOURCE) {
+            return UCS_OK;
+        } else if (status != UCS_OK) {
+            /* The request is released by purging the EP */
+            return status;
+        }
+
+        ucs_queue_pull_non_empty(&ep->get.resp_q);
+        ucs_free(resp);
+    }
+
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE int
+uct_tcp_ep_msg_zcopy_start(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                           uct_tcp_ep_zcopy_tx_t *ctx, const void *header,
+                           unsigned header_length, size_t payload_length,
+                           uct_completion_t *comp)
+{
+    if (ucs_likely(payload_length < iface->config.zcopy.msg_zcopy_thresh) ||
+        /* Unix domain sockets don't support MSG_ZEROCOPY */
+        (ep->flags & UCT_TCP_EP_FLAG_UNIX)) {
+        return 0;
+    }
+
+    /* The kernel references the sent buffers until the notification is
+     * received, so keep the header in the TX buffer which is released only
+     * upon the notification */
+    if (header_length != 0) {
+        ucs_assert(header_length <= iface->config.zcopy.max_hdr);
+        ctx->iov[1].iov_base = UCS_PTR_BYTE_OFFSET(ep->tx.buf,
+                                                   iface->config.zcopy.hdr_offset);
+        memcpy(ctx->iov[1].iov_base, header, header_length);
+    }
+
+    /* If nothing will be sent with MSG_ZEROCOPY, wait for the notification
+     * of the last MSG_ZEROCOPY send done prior to this operation */
+    ctx->comp         = comp;
+    ctx->msg_zcopy_sn = ep->msg_zcopy.sn - 1;
+    ep->flags        |= UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+    return 1;
+}
+
 ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *header,
                                  unsigned header_length, const uct_iov_t *iov,
                                  size_t iovcnt, unsigned flags,
@@ -1445,21 +2228,27 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     uct_tcp_iface_t *iface     = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
     uct_tcp_ep_zcopy_tx_t *ctx = NULL;
     size_t payload_length      = 0;
+    ucs_iov_iter_t uct_iov_iter;
     ucs_status_t status;
+    int msg_zcopy;
 
     UCT_CHECK_LENGTH(header_length + uct_iov_total_length(iov, iovcnt), 0,
                      iface->config.rx_seg_size - sizeof(uct_tcp_am_hdr_t),
                      "am_zcopy");
     UCT_CHECK_AM_ID(am_id);
 
+    ucs_iov_iter_init(&uct_iov_iter);
     status = uct_tcp_ep_prepare_zcopy(iface, ep, am_id, header, header_length,
-                                      iov, iovcnt, "am_zcopy", &payload_length,
-                                      &ctx);
+                                      iov, iovcnt, &uct_iov_iter, SIZE_MAX,
+                                      "am_zcopy", &payload_length, &ctx);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
 
     ctx->super.length = payload_length + header_length;
+    msg_zcopy         = uct_tcp_ep_msg_zcopy_start(iface, ep, ctx, header,
+                                                   header_length,
+                                                   payload_length, comp);
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, iface->config.rx_seg_size,
                                  header, ctx->iov, ctx->iov_cnt);
@@ -1475,26 +2264,28 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
         return UCS_INPROGRESS;
     }
 
-    return UCS_OK;
+    /* The operation is completed if it was not queued to wait for
+     * MSG_ZEROCOPY notifications */
+    return (msg_zcopy && !ucs_queue_is_empty(&ep->msg_zcopy.queue)) ?
+           UCS_INPROGRESS : UCS_OK;
 }
 
-ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
-                                  size_t iovcnt, uint64_t remote_addr,
-                                  uct_rkey_t rkey, uct_completion_t *comp)
+static ucs_status_t
+uct_tcp_ep_do_put_zcopy(uct_tcp_ep_t *ep, const uct_iov_t *iov, size_t iovcnt,
+                        ucs_iov_iter_t *uct_iov_iter_p, size_t max_length,
+                        uint64_t remote_addr, uct_completion_t *comp)
 {
-    uct_tcp_ep_t *ep                 = ucs_derived_of(uct_ep, uct_tcp_ep_t);
-    uct_tcp_iface_t *iface           = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_iface_t *iface           = ucs_derived_of(ep->super.super.iface,
+                                                      uct_tcp_iface_t);
     uct_tcp_ep_zcopy_tx_t *ctx       = NULL;
     uct_tcp_ep_put_req_hdr_t put_req = {0}; /* Suppress Cppcheck false-positive */
     ucs_status_t status;
-
-    UCT_CHECK_LENGTH(sizeof(put_req) + uct_iov_total_length(iov, iovcnt), 0,
-                     UCT_TCP_EP_PUT_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t),
-                     "put_zcopy");
+    int msg_zcopy;
 
     status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_PUT_REQ_AM_ID,
                                       &put_req, sizeof(put_req),
-                                      iov, iovcnt, "put_zcopy",
+                                      iov, iovcnt, uct_iov_iter_p, max_length,
+                                      "put_zcopy",
                                       /* Set a payload length directly to the
                                        * TX length, since PUT Zcopy doesn't
                                        * set the payload length to TCP AM hdr */
@@ -1507,6 +2298,9 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     put_req.addr      = remote_addr;
     put_req.length    = ep->tx.length;
     put_req.sn        = ep->tx.put_sn + 1;
+    msg_zcopy         = uct_tcp_ep_msg_zcopy_start(iface, ep, ctx, &put_req,
+                                                   sizeof(put_req),
+                                                   put_req.length, comp);
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
                                  &put_req, ctx->iov, ctx->iov_cnt);
@@ -1534,7 +2328,254 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
         return UCS_INPROGRESS;
     }
 
-    return UCS_OK;
+    /* The operation is completed if it was not queued to wait for
+     * MSG_ZEROCOPY notifications */
+    return (msg_zcopy && !ucs_queue_is_empty(&ep->msg_zcopy.queue)) ?
+           UCS_INPROGRESS : UCS_OK;
+}
+
+static void uct_tcp_ep_multi_comp_cb(uct_completion_t *self,
+                                     ucs_status_t status)
+{
+    uct_tcp_ep_multi_comp_t *mcomp = ucs_derived_of(self,
+                                                    uct_tcp_ep_multi_comp_t);
+
+    if (UCS_STATUS_IS_ERR(status) && (mcomp->status == UCS_OK)) {
+        mcomp->status = status;
+    }
+
+    if (--mcomp->count > 0) {
+        /* Re-arm the completion to be notified about the next part */
+        mcomp->super.count = 1;
+        return;
+    }
+
+    if (mcomp->comp != NULL) {
+        uct_invoke_completion(mcomp->comp, mcomp->status);
+    }
+
+    ucs_free(mcomp);
+}
+
+static uct_tcp_ep_multi_comp_t *
+uct_tcp_ep_multi_comp_alloc(uct_completion_t *comp, int count)
+{
+    uct_tcp_ep_multi_comp_t *mcomp;
+
+    mcomp = ucs_malloc(sizeof(*mcomp), "tcp_ep_multi_comp");
+    if (mcomp == NULL) {
+        return NULL;
+    }
+
+    /* The status of every part has to be checked, so the completion is
+     * invoked by each part and counts the parts by itself */
+    mcomp->super.func  = uct_tcp_ep_multi_comp_cb;
+    mcomp->super.count = 1;
+    mcomp->comp        = comp;
+    mcomp->count       = count;
+    mcomp->status      = UCS_OK;
+    return mcomp;
+}
+
+static ucs_status_t
+uct_tcp_ep_put_zcopy_part(uct_tcp_ep_t *ep, uct_tcp_ep_multi_comp_t *mcomp,
+                          const uct_iov_t *iov, size_t iovcnt,
+                          ucs_iov_iter_t *uct_iov_iter, size_t length,
+                          uint64_t remote_addr)
+{
+    ucs_status_t status;
+
+    if (mcomp == NULL) {
+        return uct_tcp_ep_do_put_zcopy(ep, iov, iovcnt, uct_iov_iter, length,
+                                       remote_addr, NULL);
+    }
+
+    /* Account the part before posting it, since its completion may be
+     * invoked before the function returns */
+    ++mcomp->count;
+    status = uct_tcp_ep_do_put_zcopy(ep, iov, iovcnt, uct_iov_iter, length,
+                                     remote_addr, &mcomp->super);
+    if (status != UCS_INPROGRESS) {
+        /* The completion won't be invoked for this part */
+        --mcomp->count;
+    }
+
+    return status;
+}
+
+static ucs_status_t
+uct_tcp_ep_put_zcopy_striped(uct_tcp_ep_t *ep, const uct_iov_t *iov,
+                             size_t iovcnt, size_t length, uint64_t remote_addr,
+                             uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface         = ucs_derived_of(ep->super.super.iface,
+                                                    uct_tcp_iface_t);
+    uct_tcp_ep_multi_comp_t *mcomp = NULL;
+    uct_tcp_ep_t *streams[UCT_TCP_EP_MAX_STREAMS];
+    ucs_iov_iter_t uct_iov_iter, prev_iov_iter;
+    unsigned i, num_parts, max_parts;
+    size_t offset, part_length;
+    ucs_status_t status, parts_status;
+
+    /* Each part has to be at least the minimal stripe size, and the EP itself
+     * always sends the last part */
+    max_parts = ucs_min(ep->streams.count + 1,
+                        length / iface->config.stripe_min_size);
+    num_parts = 1;
+    for (i = 0; (i < ep->streams.count) && (num_parts < max_parts); ++i) {
+        if (uct_tcp_ep_check_tx_res(ep->streams.eps[i]) == UCS_OK) {
+            streams[num_parts++ - 1] = ep->streams.eps[i];
+        }
+    }
+
+    if ((num_parts > 1) && (comp != NULL)) {
+        /* The user's completion is invoked once all parts are completed. The
+         * extra reference is held until all parts are posted */
+        mcomp = uct_tcp_ep_multi_comp_alloc(comp, 1);
+        if (mcomp == NULL) {
+            num_parts = 1;
+        }
+    }
+
+    part_length = length / num_parts;
+    offset      = 0;
+    ucs_iov_iter_init(&uct_iov_iter);
+
+    for (i = 0; i < (num_parts - 1); ++i) {
+        prev_iov_iter = uct_iov_iter;
+        status        = uct_tcp_ep_put_zcopy_part(streams[i], mcomp, iov,
+                                                  iovcnt, &uct_iov_iter,
+                                                  part_length,
+                                                  remote_addr + offset);
+        if (UCS_STATUS_IS_ERR(status)) {
+            /* The remaining data is sent by the EP itself */
+            ucs_trace_data("tcp_ep %p: failed to send PUT part on stream %p: "
+                           "%s", ep, streams[i], ucs_status_string(status));
+            uct_iov_iter = prev_iov_iter;
+            break;
+        }
+
+        offset += part_length;
+    }
+
+    if (mcomp == NULL) {
+        /* Use the user's completion directly */
+        return uct_tcp_ep_do_put_zcopy(ep, iov, iovcnt, &uct_iov_iter,
+                                       SIZE_MAX, remote_addr + offset, comp);
+    }
+
+    status = uct_tcp_ep_put_zcopy_part(ep, mcomp, iov, iovcnt, &uct_iov_iter,
+                                       SIZE_MAX, remote_addr + offset);
+    if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
+        /* The operation failed, so the user's completion mustn't be invoked
+         * when the parts already sent on the streams are completed */
+        mcomp->comp = NULL;
+    }
+
+    /* Release the extra reference */
+    if (--mcomp->count > 0) {
+        return UCS_STATUS_IS_ERR(status) ? status : UCS_INPROGRESS;
+    }
+
+    parts_status = mcomp->status;
+    ucs_free(mcomp);
+    return UCS_STATUS_IS_ERR(status) ? status : parts_status;
+}
+
+ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    size_t length          = uct_iov_total_length(iov, iovcnt);
+    ucs_iov_iter_t uct_iov_iter;
+
+    UCT_CHECK_LENGTH(sizeof(uct_tcp_ep_put_req_hdr_t) + length, 0,
+                     UCT_TCP_EP_PUT_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t),
+                     "put_zcopy");
+
+    if ((ep->streams.count > 0) &&
+        (length >= (2 * iface->config.stripe_min_size)) &&
+        (uct_tcp_ep_check_tx_res(ep) == UCS_OK)) {
+        return uct_tcp_ep_put_zcopy_striped(ep, iov, iovcnt, length,
+                                            remote_addr, comp);
+    }
+
+    ucs_iov_iter_init(&uct_iov_iter);
+    return uct_tcp_ep_do_put_zcopy(ep, iov, iovcnt, &uct_iov_iter, SIZE_MAX,
+                                   remote_addr, comp);
+}
+
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    size_t length          = uct_iov_total_length(iov, iovcnt);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_get_req_hdr_t *get_req;
+    uct_tcp_ep_get_op_t *op;
+    ucs_iov_iter_t uct_iov_iter;
+    size_t io_vec_cnt;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, iface->config.zcopy.max_iov -
+                       UCT_TCP_EP_ZCOPY_SERVICE_IOV_COUNT, "get_zcopy");
+    UCT_CHECK_LENGTH(UCT_TCP_EP_GET_SERVICE_LENGTH + length, 0,
+                     UCT_TCP_EP_PUT_ZCOPY_MAX, "get_zcopy");
+
+    if (ucs_unlikely(length == 0)) {
+        return UCS_OK;
+    }
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+
+    /* The operation keeps the user's buffers until the response arrives */
+    op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_assert((sizeof(*op) + (sizeof(struct iovec) * iovcnt)) <=
+               iface->config.tx_seg_size);
+
+    ucs_iov_iter_init(&uct_iov_iter);
+    io_vec_cnt    = iovcnt;
+    op->comp      = comp;
+    op->iov_index = 0;
+    op->length    = uct_iov_to_iovec(op->iov, &io_vec_cnt, iov, iovcnt,
+                                     SIZE_MAX, &uct_iov_iter);
+    op->iov_cnt   = io_vec_cnt;
+    ucs_assert((op->length == length) && (op->iov_cnt > 0));
+
+    hdr->length     = sizeof(*get_req);
+    get_req         = (uct_tcp_ep_get_req_hdr_t*)(hdr + 1);
+    get_req->addr   = remote_addr;
+    get_req->length = length;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_mpool_put_inline(op);
+        return status;
+    }
+
+    /* Add the operation only after sending the request, since the EP purges
+     * the GET operations if sending fails */
+    ucs_queue_push(&ep->get.ops, &op->queue);
+    ep->get.sn++;
+    uct_tcp_iface_outstanding_inc(iface);
+
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, length);
+
+    return UCS_INPROGRESS;
 }
 
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
@@ -1560,11 +2601,33 @@ void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
     uct_pending_queue_purge(priv, &ep->pending_q, 1, cb, arg);
 }
 
+static int uct_tcp_ep_is_put_waiting(uct_tcp_ep_t *ep)
+{
+    return (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) ||
+           !ucs_queue_is_empty(&ep->msg_zcopy.queue) ||
+           !ucs_queue_is_empty(&ep->get.ops);
+}
+
+static void uct_tcp_ep_add_put_comp(uct_tcp_ep_t *ep,
+                                    uct_tcp_ep_put_completion_t *put_comp,
+                                    uct_completion_t *comp)
+{
+    put_comp->wait_put_sn       = ep->tx.put_sn;
+    put_comp->wait_msg_zcopy_sn = ep->msg_zcopy.sn - 1;
+    put_comp->wait_get_sn       = ep->get.sn;
+    put_comp->comp              = comp;
+    ucs_queue_push(&ep->put_comp_q, &put_comp->elem);
+}
+
 ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp)
 {
-    uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
-    uct_tcp_ep_put_completion_t *put_comp;
+    uct_tcp_ep_t *ep               = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_ep_multi_comp_t *mcomp = NULL;
+    uct_tcp_ep_t *waiting_eps[UCT_TCP_EP_MAX_STREAMS];
+    uct_tcp_ep_put_completion_t *put_comps[UCT_TCP_EP_MAX_STREAMS];
+    unsigned i, num_waiting;
+    uct_tcp_ep_t *stream;
 
     if (ucs_unlikely(flags & UCT_FLUSH_FLAG_CANCEL)) {
         /* TCP is able to cancel only pending operations, posted TX operations
@@ -1581,22 +2644,76 @@ ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
         return UCS_ERR_NO_RESOURCE;
     }
 
-    if (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
-        if (comp != NULL) {
-            put_comp = ucs_calloc(1, sizeof(*put_comp), "put completion");
-            if (put_comp == NULL) {
-                return UCS_ERR_NO_MEMORY;
-            }
+    /* Streams send only PUT operations, so their completion is defined by
+     * PUT ACKs and MSG_ZEROCOPY notifications. The user's EP also waits for
+     * the responses of GET operations */
+    num_waiting = 0;
+    if (uct_tcp_ep_is_put_waiting(ep)) {
+        waiting_eps[num_waiting++] = ep;
+    }
 
-            put_comp->wait_put_sn = ep->tx.put_sn;
-            put_comp->comp        = comp;
-            ucs_queue_push(&ep->put_comp_q, &put_comp->elem);
+    for (i = 0; i < ep->streams.count; ++i) {
+        stream = ep->streams.eps[i];
+        if ((stream->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
+            uct_tcp_ep_is_put_waiting(stream)) {
+            waiting_eps[num_waiting++] = stream;
         }
+    }
+
+    if (num_waiting == 0) {
+        UCT_TL_EP_STAT_FLUSH(&ep->super);
+        return UCS_OK;
+    }
 
+    if (comp == NULL) {
         return UCS_INPROGRESS;
     }
 
-    UCT_TL_EP_STAT_FLUSH(&ep->super);
-    return UCS_OK;
+    for (i = 0; i < num_waiting; ++i) {
+        put_comps[i] = ucs_calloc(1, sizeof(*put_comps[i]), "put completion");
+        if (put_comps[i] == NULL) {
+            goto err_free_put_comps;
+        }
+    }
+
+    if (num_waiting > 1) {
+        /* The user's completion is invoked once all EPs are flushed */
+        mcomp = uct_tcp_ep_multi_comp_alloc(comp, num_waiting);
+        if (mcomp == NULL) {
+            goto err_free_put_comps;
+        }
+
+        comp = &mcomp->super;
+    }
+
+    for (i = 0; i < num_waiting; ++i) {
+        uct_tcp_ep_add_put_comp(waiting_eps[i], put_comps[i], comp);
+    }
+
+    return UCS_INPROGRESS;
+
+err_free_put_comps:
+    while (i-- > 0) {
+        ucs_free(put_comps[i]);
+    }
+    return UCS_ERR_NO_MEMORY;
+}
+
+ucs_status_t uct_tcp_ep_fence(uct_ep_h tl_ep, unsigned flags)
+{
+    uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+
+    if (ep->streams.count > 0) {
+        /* Operations posted after the fence mustn't overtake PUT operations
+         * which are being sent on the streams */
+        ep->flags |= UCT_TCP_EP_FLAG_FENCE;
+        if (uct_tcp_ep_is_fenced(ep) && (ep->fd != -1)) {
+            /* Poll the EP until the fence is released to dispatch pending
+             * operations */
+            uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+        }
+    }
+
+    return uct_base_ep_fence(tl_ep, flags);
 }
 
@@ -15,6 +15,7 @@
 #include <ucs/config/types.h>
 #include <sys/socket.h>
 #include <sys/poll.h>
+#include <sys/un.h>
 #include <netinet/tcp.h>
 #include <dirent.h>
 
@@ -43,6 +44,25 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"MSG_ZCOPY_THRESH", "inf",
+   "Threshold for sending AM/PUT Zcopy payload with MSG_ZEROCOPY flag, i.e.\n"
+   "without copying the data to the kernel socket buffer. The completion of\n"
+   "such operation is reported only after the kernel notifies that the user\n"
+   "buffer is no longer in use. \"inf\" disables MSG_ZEROCOPY sends",
+   ucs_offsetof(uct_tcp_iface_config_t, msg_zcopy_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"NUM_STREAMS", "1",
+   "Number of sockets which are used to send data to a peer. Active messages\n"
+   "are always sent on the first socket to keep their ordering, while large\n"
+   "PUT Zcopy operations are split between the sockets that are ready to send",
+   ucs_offsetof(uct_tcp_iface_config_t, num_streams), UCS_CONFIG_TYPE_UINT},
+
+  {"STRIPE_MIN_SIZE", "64kb",
+   "Minimal length of a PUT Zcopy part which is sent on a separate socket",
+   ucs_offsetof(uct_tcp_iface_config_t, stripe_min_size),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -51,11 +71,26 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Enable PUT Zcopy support",
    ucs_offsetof(uct_tcp_iface_config_t, put_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"GET_ENABLE", "y",
+   "Enable GET Zcopy support. The peer reads the requested data directly from\n"
+   "its memory and sends it back, where it is received to the user's buffers.",
+   ucs_offsetof(uct_tcp_iface_config_t, get_enable), UCS_CONFIG_TYPE_BOOL},
+
   {"CONN_NB", "n",
    "Enable non-blocking connection establishment. It may improve startup "
    "time, but can lead to connection resets due to high load on TCP/IP stack",
    ucs_offsetof(uct_tcp_iface_config_t, conn_nb), UCS_CONFIG_TYPE_BOOL},
 
+  {"UNIX_SOCKETS", "y",
+   "Connect to peers on the same host using Unix domain sockets instead of\n"
+   "the TCP/IP loopback. A peer is considered to be on the same host if it\n"
+   "accepts a connection on the Unix domain socket whose abstract name is\n"
+   "derived from its network address, otherwise TCP is used.\n"
+   "The socket name is in the abstract namespace, which is private to a\n"
+   "network namespace: processes on the same host but in different network\n"
+   "namespaces (e.g. containers without host networking) use TCP.",
+   ucs_offsetof(uct_tcp_iface_config_t, unix_enable), UCS_CONFIG_TYPE_BOOL},
+
   {"MAX_POLL", UCS_PP_MAKE_STRING(UCT_TCP_MAX_EVENTS),
    "Number of times to poll on a ready socket. 0 - no polling, -1 - until drained",
    ucs_offsetof(uct_tcp_iface_config_t, max_poll), UCS_CONFIG_TYPE_UINT},
@@ -72,6 +107,20 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
 
   UCT_TCP_SEND_RECV_BUF_FIELDS(ucs_offsetof(uct_tcp_iface_config_t, sockopt)),
 
+  {"BUSY_POLL", "0",
+   "Set SO_BUSY_POLL socket option to make the kernel busy poll the device RX\n"
+   "queue for this amount of time when the socket has no data to receive,\n"
+   "instead of waiting for an interrupt. This reduces latency at the cost of\n"
+   "CPU usage. Values above net.core.busy_read require CAP_NET_ADMIN.\n"
+   "0 disables busy polling",
+   ucs_offsetof(uct_tcp_iface_config_t, sockopt_busy_poll), UCS_CONFIG_TYPE_TIME},
+
+  {"PREFER_BUSY_POLL", "n",
+   "Set SO_PREFER_BUSY_POLL socket option to defer device interrupts and let\n"
+   "busy polling process the RX queue while the application keeps polling",
+   ucs_offsetof(uct_tcp_iface_config_t, sockopt_prefer_busy_poll),
+   UCS_CONFIG_TYPE_BOOL},
+
   UCT_TCP_SYN_CNT(ucs_offsetof(uct_tcp_iface_config_t, syn_cnt)),
 
   UCT_IFACE_MPOOL_CONFIG_FIELDS("TX_", -1, 8, "send",
@@ -116,6 +165,7 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
     size_t am_buf_size     = iface->config.tx_seg_size - sizeof(uct_tcp_am_hdr_t);
+    size_t zcopy_align;
     ucs_status_t status;
     int is_default;
 
@@ -142,6 +192,13 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
     attr->cap.am.max_short = am_buf_size;
     attr->cap.am.max_bcopy = am_buf_size;
 
+    /* MSG_ZEROCOPY pins the pages of user's buffer, so page-aligned
+     * buffers are preferred to avoid sharing pages between operations. The
+     * alignment is reported for the whole Zcopy range, so request it only
+     * if every Zcopy operation is sent with MSG_ZEROCOPY */
+    zcopy_align = (iface->config.zcopy.msg_zcopy_thresh == 0) ?
+                  ucs_get_page_size() : 1;
+
     if (iface->config.zcopy.max_iov > UCT_TCP_EP_ZCOPY_SERVICE_IOV_COUNT) {
         /* AM */
         attr->cap.am.max_iov          = iface->config.zcopy.max_iov -
@@ -149,7 +206,7 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
         attr->cap.am.max_zcopy        = iface->config.rx_seg_size -
                                         sizeof(uct_tcp_am_hdr_t);
         attr->cap.am.max_hdr          = iface->config.zcopy.max_hdr;
-        attr->cap.am.opt_zcopy_align  = 1;
+        attr->cap.am.opt_zcopy_align  = zcopy_align;
         attr->cap.flags              |= UCT_IFACE_FLAG_AM_ZCOPY;
 
         if (iface->config.put_enable) {
@@ -158,9 +215,19 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
                                              UCT_TCP_EP_ZCOPY_SERVICE_IOV_COUNT;
             attr->cap.put.max_zcopy        = UCT_TCP_EP_PUT_ZCOPY_MAX -
                                              UCT_TCP_EP_PUT_SERVICE_LENGTH;
-            attr->cap.put.opt_zcopy_align  = 1;
+            attr->cap.put.opt_zcopy_align  = zcopy_align;
             attr->cap.flags               |= UCT_IFACE_FLAG_PUT_ZCOPY;
         }
+
+        if (iface->config.get_enable) {
+            /* GET */
+            attr->cap.get.max_iov          = iface->config.zcopy.max_iov -
+                                             UCT_TCP_EP_ZCOPY_SERVICE_IOV_COUNT;
+            attr->cap.get.max_zcopy        = UCT_TCP_EP_PUT_ZCOPY_MAX -
+                                             UCT_TCP_EP_GET_SERVICE_LENGTH;
+            attr->cap.get.opt_zcopy_align  = 1;
+            attr->cap.flags               |= UCT_IFACE_FLAG_GET_ZCOPY;
+        }
     }
 
     attr->bandwidth.dedicated = 0;
@@ -194,7 +261,19 @@ static void uct_tcp_iface_handle_events(void *callback_data,
     unsigned *count  = (unsigned*)arg;
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)callback_data;
 
-    ucs_assertv(ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED, "ep=%p", ep);
+    if (ucs_unlikely(ep->conn_state == UCT_TCP_EP_CONN_STATE_CLOSED)) {
+        /* The EP was closed while dispatching the events of another EP (e.g.
+         * a stream of a failed EP), its socket isn't polled anymore */
+        ucs_assertv(ep->events == 0, "ep=%p", ep);
+        return;
+    }
+
+    if ((events & UCS_EVENT_SET_EVERR) &&
+        !ucs_queue_is_empty(&ep->msg_zcopy.queue)) {
+        /* MSG_ZEROCOPY notifications are delivered through the socket error
+         * queue, handle them before RX progress that may destroy the EP */
+        *count += uct_tcp_ep_progress_msg_zcopy(ep);
+    }
 
     if (events & UCS_EVENT_SET_EVREAD) {
         *count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
@@ -225,6 +304,10 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     } while ((max_events > 0) && (read_events == UCT_TCP_MAX_EVENTS) &&
              ((status == UCS_OK) || (status == UCS_INPROGRESS)));
 
+    if (ucs_unlikely(!ucs_list_is_empty(&iface->stream_gc_list))) {
+        uct_tcp_iface_stream_gc(iface);
+    }
+
     return count;
 }
 
@@ -249,26 +332,32 @@ static ucs_status_t uct_tcp_iface_flush(uct_iface_h tl_iface, unsigned flags,
 static void uct_tcp_iface_connect_handler(int listen_fd, int events, void *arg)
 {
     uct_tcp_iface_t *iface = arg;
-    struct sockaddr_in peer_addr;
+    struct sockaddr_storage peer_addr;
     socklen_t addrlen;
     ucs_status_t status;
+    int *listen_fd_p;
     int fd;
 
-    ucs_assert(listen_fd == iface->listen_fd);
+    ucs_assert((listen_fd == iface->listen_fd) ||
+               (listen_fd == iface->unix_listen_fd));
+    listen_fd_p = (listen_fd == iface->listen_fd) ? &iface->listen_fd :
+                  &iface->unix_listen_fd;
 
     for (;;) {
         addrlen = sizeof(peer_addr);
-        status  = ucs_socket_accept(iface->listen_fd, (struct sockaddr*)&peer_addr,
+        status  = ucs_socket_accept(*listen_fd_p, (struct sockaddr*)&peer_addr,
                                     &addrlen, &fd);
         if (status != UCS_OK) {
             if (status != UCS_ERR_NO_PROGRESS) {
-                ucs_close_fd(&iface->listen_fd);
+                ucs_close_fd(listen_fd_p);
             }
             return;
         }
         ucs_assert(fd != -1);
 
-        status = uct_tcp_cm_handle_incoming_conn(iface, &peer_addr, fd);
+        status = uct_tcp_cm_handle_incoming_conn(iface,
+                                                 (struct sockaddr*)&peer_addr,
+                                                 fd);
         if (status != UCS_OK) {
             close(fd);
             return;
@@ -276,10 +365,24 @@ static void uct_tcp_iface_connect_handler(int listen_fd, int events, void *arg)
     }
 }
 
-ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd)
+ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
+                                       int is_unix)
 {
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    int optval = 1;
+#endif
+    size_t sndbuf, rcvbuf;
     ucs_status_t status;
 
+    if (is_unix) {
+        /* TCP options don't apply to Unix domain sockets */
+        sndbuf = (iface->sockopt.sndbuf == UCS_MEMUNITS_AUTO) ?
+                 UCT_TCP_UNIX_SOCKBUF_SIZE : iface->sockopt.sndbuf;
+        rcvbuf = (iface->sockopt.rcvbuf == UCS_MEMUNITS_AUTO) ?
+                 UCT_TCP_UNIX_SOCKBUF_SIZE : iface->sockopt.rcvbuf;
+        return ucs_socket_set_buffer_size(fd, sndbuf, rcvbuf);
+    }
+
     status = ucs_socket_setopt(fd, IPPROTO_TCP, TCP_NODELAY,
                                (const void*)&iface->sockopt.nodelay,
                                sizeof(int));
@@ -293,6 +396,38 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd)
         return status;
     }
 
+#if HAVE_DECL_SO_BUSY_POLL
+    if (iface->sockopt.busy_poll != 0) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+                                   (const void*)&iface->sockopt.busy_poll,
+                                   sizeof(int));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
+#if HAVE_DECL_SO_PREFER_BUSY_POLL
+    if (iface->sockopt.prefer_busy_poll) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL,
+                                   (const void*)&iface->sockopt.prefer_busy_poll,
+                                   sizeof(int));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    if (iface->config.zcopy.msg_zcopy_thresh != SIZE_MAX) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_ZEROCOPY,
+                                   (const void*)&optval, sizeof(optval));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
     return ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
 }
 
@@ -301,10 +436,11 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
     .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
-    .ep_fence                 = uct_base_ep_fence,
+    .ep_fence                 = uct_tcp_ep_fence,
     .ep_create                = uct_tcp_ep_create,
     .ep_destroy               = uct_tcp_ep_destroy,
     .iface_flush              = uct_tcp_iface_flush,
@@ -321,6 +457,119 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .iface_is_reachable       = uct_tcp_iface_is_reachable
 };
 
+static void uct_tcp_iface_unix_addr(const struct sockaddr_in *in_addr,
+                                     struct sockaddr_un *un_addr,
+                                     socklen_t *addrlen_p)
+{
+    int len;
+
+    /* Use the abstract namespace, so the name is released when the socket is
+     * closed. The TCP address of the listening socket makes it unique */
+    memset(un_addr, 0, sizeof(*un_addr));
+    un_addr->sun_family = AF_UNIX;
+    len                 = snprintf(un_addr->sun_path + 1,
+                                   sizeof(un_addr->sun_path) - 1,
+                                   "ucx-tcp-%08x-%u",
+                                   ntohl(in_addr->sin_addr.s_addr),
+                                   ntohs(in_addr->sin_port));
+    *addrlen_p          = offsetof(struct sockaddr_un, sun_path) + 1 + len;
+}
+
+ucs_status_t uct_tcp_iface_unix_connect(uct_tcp_iface_t *iface, int fd,
+                                        const struct sockaddr_in *peer_addr)
+{
+    struct sockaddr_un un_addr;
+    socklen_t addrlen;
+    ucs_status_t status;
+    int ret;
+
+    status = ucs_sys_fcntl_modfl(fd, O_NONBLOCK, 0);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* Connecting to a Unix domain socket does not wait for the peer to
+     * accept it. It fails immediately if there is no such socket, i.e. the
+     * peer is on another host, or if the peer's backlog is full */
+    uct_tcp_iface_unix_addr(peer_addr, &un_addr, &addrlen);
+    do {
+        ret = connect(fd, (struct sockaddr*)&un_addr, addrlen);
+    } while ((ret < 0) && (errno == EINTR));
+
+    if (ret == 0) {
+        ucs_debug("tcp_iface %p: connected to %s (fd=%d)", iface,
+                  un_addr.sun_path + 1, fd);
+        return UCS_OK;
+    } else if (errno == EINPROGRESS) {
+        return UCS_INPROGRESS;
+    }
+
+    ucs_trace("tcp_iface %p: connect(%s) failed: %m", iface,
+              un_addr.sun_path + 1);
+    return UCS_ERR_UNREACHABLE;
+}
+
+static ucs_status_t uct_tcp_iface_unix_listener_init(uct_tcp_iface_t *iface)
+{
+    struct sockaddr_un un_addr;
+    socklen_t addrlen;
+    ucs_status_t status;
+
+    iface->unix_listen_fd = -1;
+
+    if (!iface->config.unix_enable) {
+        return UCS_OK;
+    }
+
+    status = ucs_socket_create(AF_UNIX, SOCK_STREAM, &iface->unix_listen_fd);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
+    status = ucs_sys_fcntl_modfl(iface->unix_listen_fd, O_NONBLOCK, 0);
+    if (status != UCS_OK) {
+        goto err_close_sock;
+    }
+
+    /* Peers fall back to TCP if the Unix domain socket is not available, so
+     * failing to create it is not fatal for the interface */
+    uct_tcp_iface_unix_addr(&iface->config.ifaddr, &un_addr, &addrlen);
+    if (bind(iface->unix_listen_fd, (struct sockaddr*)&un_addr, addrlen) < 0) {
+        ucs_diag("bind(fd=%d, %s) failed: %m, local peers will use TCP",
+                 iface->unix_listen_fd, un_addr.sun_path + 1);
+        goto out_disable;
+    }
+
+    if (listen(iface->unix_listen_fd, ucs_socket_max_conn()) < 0) {
+        ucs_diag("listen(fd=%d, %s) failed: %m, local peers will use TCP",
+                 iface->unix_listen_fd, un_addr.sun_path + 1);
+        goto out_disable;
+    }
+
+    status = ucs_async_set_event_handler(iface->super.worker->async->mode,
+                                         iface->unix_listen_fd,
+                                         UCS_EVENT_SET_EVREAD |
+                                         UCS_EVENT_SET_EVERR,
+                                         uct_tcp_iface_connect_handler, iface,
+                                         iface->super.worker->async);
+    if (status != UCS_OK) {
+        goto err_close_sock;
+    }
+
+    ucs_debug("tcp_iface %p: listening for local connections (fd=%d) on %s",
+              iface, iface->unix_listen_fd, un_addr.sun_path + 1);
+    return UCS_OK;
+
+out_disable:
+    ucs_close_fd(&iface->unix_listen_fd);
+    return UCS_OK;
+
+err_close_sock:
+    ucs_close_fd(&iface->unix_listen_fd);
+err:
+    return status;
+}
+
 static ucs_status_t uct_tcp_iface_listener_init(uct_tcp_iface_t *iface)
 {
     struct sockaddr_in bind_addr = iface->config.ifaddr;
@@ -369,6 +618,103 @@ err:
     return status;
 }
 
+static size_t uct_tcp_iface_msg_zcopy_thresh(size_t thresh)
+{
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    int optval = 1;
+    ucs_status_t status;
+    int fd, ret;
+
+    if (thresh == UCS_MEMUNITS_INF) {
+        return SIZE_MAX;
+    }
+
+    /* Check that the kernel supports SO_ZEROCOPY socket option */
+    status = ucs_socket_create(AF_INET, SOCK_STREAM, &fd);
+    if (status != UCS_OK) {
+        return SIZE_MAX;
+    }
+
+    ret = setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval));
+    ucs_close_fd(&fd);
+    if (ret < 0) {
+        ucs_diag("setsockopt(SO_ZEROCOPY) failed: %m, MSG_ZEROCOPY sends "
+                 "are disabled");
+        return SIZE_MAX;
+    }
+
+    return thresh;
+#else
+    if (thresh != UCS_MEMUNITS_INF) {
+        ucs_diag("MSG_ZEROCOPY is not supported, ignoring %s%sMSG_ZCOPY_THRESH",
+                 UCS_DEFAULT_ENV_PREFIX, UCT_TCP_CONFIG_PREFIX);
+    }
+
+    return SIZE_MAX;
+#endif
+}
+
+#if HAVE_DECL_SO_BUSY_POLL || HAVE_DECL_SO_PREFER_BUSY_POLL
+static int uct_tcp_iface_sockopt_check(int optname, const char *optstr,
+                                       int optval)
+{
+    ucs_status_t status;
+    int fd, ret;
+
+    status = ucs_socket_create(AF_INET, SOCK_STREAM, &fd);
+    if (status != UCS_OK) {
+        return 0;
+    }
+
+    ret = setsockopt(fd, SOL_SOCKET, optname, &optval, sizeof(optval));
+    ucs_close_fd(&fd);
+    if (ret < 0) {
+        ucs_diag("setsockopt(%s=%d) failed: %m, ignoring %s%s option",
+                 optstr, optval, UCS_DEFAULT_ENV_PREFIX, UCT_TCP_CONFIG_PREFIX);
+        return 0;
+    }
+
+    return 1;
+}
+#endif
+
+/* Check that the kernel allows the requested busy polling options, and
+ * disable the ones it rejects rather than failing every connection */
+static void uct_tcp_iface_busy_poll_init(uct_tcp_iface_t *iface,
+                                         const uct_tcp_iface_config_t *config)
+{
+    int busy_poll = (int)ucs_min(config->sockopt_busy_poll * UCS_USEC_PER_SEC,
+                                 INT_MAX);
+
+    iface->sockopt.busy_poll        = 0;
+    iface->sockopt.prefer_busy_poll = 0;
+
+    if (busy_poll > 0) {
+#if HAVE_DECL_SO_BUSY_POLL
+        if (uct_tcp_iface_sockopt_check(SO_BUSY_POLL, "SO_BUSY_POLL",
+                                        busy_poll)) {
+            iface->sockopt.busy_poll = busy_poll;
+        }
+#else
+        ucs_diag("SO_BUSY_POLL is not supported, ignoring %s%sBUSY_POLL",
+                 UCS_DEFAULT_ENV_PREFIX, UCT_TCP_CONFIG_PREFIX);
+#endif
+    }
+
+    if (config->sockopt_prefer_busy_poll) {
+#if HAVE_DECL_SO_PREFER_BUSY_POLL
+        if (uct_tcp_iface_sockopt_check(SO_PREFER_BUSY_POLL,
+                                        "SO_PREFER_BUSY_POLL", 1)) {
+            iface->sockopt.prefer_busy_poll = 1;
+        }
+#else
+        ucs_diag("SO_PREFER_BUSY_POLL is not supported, ignoring "
+                 "%s%sPREFER_BUSY_POLL", UCS_DEFAULT_ENV_PREFIX,
+                 UCT_TCP_CONFIG_PREFIX);
+#endif
+    }
+}
+
 static ucs_mpool_ops_t uct_tcp_mpool_ops = {
     ucs_mpool_chunk_malloc,
     ucs_mpool_chunk_free,
@@ -444,19 +790,36 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    if ((config->num_streams < 1) ||
+        (config->num_streams > UCT_TCP_EP_MAX_STREAMS)) {
+        ucs_error("unsupported value was specified (%u) for the number of "
+                  "streams, expected in range [1..%u]", config->num_streams,
+                  UCT_TCP_EP_MAX_STREAMS);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     self->config.zcopy.max_hdr     = self->config.tx_seg_size -
                                      self->config.zcopy.hdr_offset;
+    self->config.zcopy.msg_zcopy_thresh =
+        uct_tcp_iface_msg_zcopy_thresh(config->msg_zcopy_thresh);
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
+    self->config.get_enable        = config->get_enable;
+    self->config.num_streams       = config->put_enable ?
+                                     config->num_streams : 1;
+    self->config.stripe_min_size   = ucs_max(config->stripe_min_size, 1);
     self->config.conn_nb           = config->conn_nb;
+    self->config.unix_enable       = config->unix_enable;
     self->config.max_poll          = config->max_poll;
     self->config.max_conn_retries  = config->max_conn_retries;
     self->config.syn_cnt           = config->syn_cnt;
     self->sockopt.nodelay          = config->sockopt_nodelay;
     self->sockopt.sndbuf           = config->sockopt.sndbuf;
     self->sockopt.rcvbuf           = config->sockopt.rcvbuf;
+    uct_tcp_iface_busy_poll_init(self, config);
 
     ucs_list_head_init(&self->ep_list);
+    ucs_list_head_init(&self->stream_gc_list);
     ucs_conn_match_init(&self->conn_match_ctx,
                         ucs_field_sizeof(uct_tcp_ep_t, peer_addr),
                         &uct_tcp_cm_conn_match_ops);
@@ -504,8 +867,18 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_event_set;
     }
 
+    /* The name of Unix domain socket is derived from TCP address, so create
+     * it after the TCP listening port is selected */
+    status = uct_tcp_iface_unix_listener_init(self);
+    if (status != UCS_OK) {
+        goto err_cleanup_listener;
+    }
+
     return UCS_OK;
 
+err_cleanup_listener:
+    ucs_async_remove_handler(self->listen_fd, 1);
+    ucs_close_fd(&self->listen_fd);
 err_cleanup_event_set:
     ucs_event_set_cleanup(self->event_set);
 err_cleanup_rx_mpool:
@@ -525,6 +898,17 @@ static void uct_tcp_iface_ep_list_cleanup(uct_tcp_iface_t *iface)
     }
 }
 
+void uct_tcp_iface_stream_gc(uct_tcp_iface_t *iface)
+{
+    uct_tcp_ep_t *ep;
+
+    while (!ucs_list_is_empty(&iface->stream_gc_list)) {
+        ep = ucs_list_head(&iface->stream_gc_list, uct_tcp_ep_t, list);
+        /* EP cleanup removes the EP from the list */
+        uct_tcp_ep_destroy_internal(&ep->super.super);
+    }
+}
+
 void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -572,13 +956,23 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
         ucs_warn("failed to remove handler for server socket fd=%d", self->listen_fd);
     }
 
+    if (self->unix_listen_fd != -1) {
+        status = ucs_async_remove_handler(self->unix_listen_fd, 1);
+        if (status != UCS_OK) {
+            ucs_warn("failed to remove handler for server socket fd=%d",
+                     self->unix_listen_fd);
+        }
+    }
+
     uct_tcp_iface_ep_list_cleanup(self);
     ucs_conn_match_cleanup(&self->conn_match_ctx);
+    uct_tcp_iface_stream_gc(self);
 
     ucs_mpool_cleanup(&self->rx_mpool, 1);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
     ucs_close_fd(&self->listen_fd);
+    ucs_close_fd(&self->unix_listen_fd);
     ucs_event_set_cleanup(self->event_set);
 }
 
@@ -1435,3 +1435,106 @@ UCS_MT_TEST_F(malloc_hook_dlopen, dlopen_mt_with_memtype, 2) {
 
     event.unset();
 }
+
+class malloc_hook_uffd : public ucs::test {
+protected:
+    virtual void init() {
+        ucs_status_t status;
+
+        ucs::skip_on_address_sanitizer();
+        ucs::test::init();
+
+        m_tid        = ucs_get_tid();
+        m_start      = 0;
+        m_end        = 0;
+        m_saved_mode = ucm_global_opts.mmap_hook_mode;
+        ucm_global_opts.mmap_hook_mode = UCM_MMAP_HOOK_UFFD;
+
+        status = ucm_set_event_handler(UCM_EVENT_VM_UNMAPPED, 0,
+                                       unmapped_cb, this);
+        if (status == UCS_ERR_UNSUPPORTED) {
+            ucm_global_opts.mmap_hook_mode = m_saved_mode;
+            UCS_TEST_SKIP_R("userfaultfd events are not supported");
+        }
+        ASSERT_UCS_OK(status);
+    }
+
+    virtual void cleanup() {
+        ucm_unset_event_handler(UCM_EVENT_VM_UNMAPPED, unmapped_cb, this);
+        ucm_global_opts.mmap_hook_mode = m_saved_mode;
+        ucs::test::cleanup();
+    }
+
+    static void unmapped_cb(ucm_event_type_t event_type, ucm_event_t *event,
+                            void *arg)
+    {
+        malloc_hook_uffd *self = reinterpret_cast<malloc_hook_uffd*>(arg);
+        uintptr_t start        = (uintptr_t)event->vm_unmapped.address;
+
+        /* Hooks installed by other tests report the release synchronously from
+         * the calling thread; count only what the uffd monitor thread sent */
+        if (ucs_get_tid() == self->m_tid) {
+            return;
+        }
+
+        self->m_start = start;
+        self->m_end   = start + event->vm_unmapped.size;
+    }
+
+    void *map_watched(size_t size, bool watch = true) {
+        void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        EXPECT_NE(MAP_FAILED, ptr);
+        memset(ptr, 0, size);
+        if (watch) {
+            EXPECT_UCS_OK(ucm_vm_watch(ptr, size));
+        }
+        return ptr;
+    }
+
+    bool wait_for_event(void *ptr, size_t size, double timeout = 2.0) {
+        ucs_time_t deadline = ucs_get_time() + ucs_time_from_sec(timeout);
+
+        while (ucs_get_time() < deadline) {
+            if ((m_start <= (uintptr_t)ptr) &&
+                (m_end >= (uintptr_t)ptr + size)) {
+                return true;
+            }
+            usleep(1000);
+        }
+        return false;
+    }
+
+    pid_t                 m_tid;
+    ucm_mmap_hook_mode_t  m_saved_mode;
+    volatile uintptr_t    m_start;
+    volatile uintptr_t    m_end;
+};
+
+UCS_TEST_SKIP_COND_F(malloc_hook_uffd, munmap, RUNNING_ON_VALGRIND) {
+    size_t size = 4 * ucs_get_page_size();
+    void *ptr   = map_watched(size);
+
+    munmap(ptr, size);
+    EXPECT_TRUE(wait_for_event(ptr, size));
+}
+
+UCS_TEST_SKIP_COND_F(malloc_hook_uffd, madvise, RUNNING_ON_VALGRIND) {
+    size_t size = 4 * ucs_get_page_size();
+    void *ptr   = map_watched(size);
+
+    madvise(ptr, size, MADV_DONTNEED);
+    EXPECT_TRUE(wait_for_event(ptr, size));
+
+    /* the range is not watched anymore, so touching it must not block */
+    memset(ptr, 1, size);
+    munmap(ptr, size);
+}
+
+UCS_TEST_SKIP_COND_F(malloc_hook_uffd, not_watched, RUNNING_ON_VALGRIND) {
+    size_t size = 4 * ucs_get_page_size();
+    void *ptr   = map_watched(size, false);
+
+    munmap(ptr, size);
+    EXPECT_FALSE(wait_for_event(ptr, size, 0.2));
+}
@@ -116,6 +116,8 @@ public:
     void test_xfer_contig(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_generic(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_iov(size_t size, bool expected, bool sync, bool truncated);
+    void test_xfer_contig_to_iov(size_t size, bool expected, bool sync,
+                                 bool truncated);
     void test_xfer_generic_err(size_t size, bool expected, bool sync, bool truncated);
 
 protected:
@@ -417,6 +419,44 @@ void test_ucp_tag_xfer::test_xfer_iov(size_t size, bool expected, bool sync,
                                "IOV"));
 }
 
+void test_ucp_tag_xfer::test_xfer_contig_to_iov(size_t size, bool expected,
+                                                bool sync, bool truncated)
+{
+    const size_t iovcnt = 20;
+    std::vector<char> sendbuf(size, 0);
+    std::vector<char> recvbuf(size, 0);
+    request *rreq, *sreq;
+
+    ucs::fill_random(sendbuf);
+
+    ucp::data_type_desc_t recv_dt_desc(DATATYPE_IOV, recvbuf.data(),
+                                       recvbuf.size(), iovcnt);
+
+    if (expected) {
+        rreq = recv_nb(recv_dt_desc.buf(), recv_dt_desc.count(), DATATYPE_IOV,
+                       RECV_TAG, RECV_MASK);
+        sreq = do_send(sendbuf.data(), sendbuf.size(), DATATYPE, sync);
+    } else {
+        sreq = do_send(sendbuf.data(), sendbuf.size(), DATATYPE, sync);
+        wait_for_unexpected_msg(receiver().worker(), 10.0);
+        rreq = recv_nb(recv_dt_desc.buf(), recv_dt_desc.count(), DATATYPE_IOV,
+                       RECV_TAG, RECV_MASK);
+    }
+
+    wait(rreq);
+    if (sreq != NULL) {
+        wait(sreq);
+        request_release(sreq);
+    }
+
+    EXPECT_UCS_OK(rreq->status);
+    EXPECT_EQ(sendbuf.size(), rreq->info.length);
+    EXPECT_TRUE(!check_buffers(sendbuf, recvbuf, rreq->info.length, 1,
+                               recv_dt_desc.count(), size, expected, sync,
+                               "contig->IOV"));
+    request_release(rreq);
+}
+
 void test_ucp_tag_xfer::test_xfer_generic_err(size_t size, bool expected,
                                               bool sync, bool truncated)
 {
@@ -668,6 +708,16 @@ UCS_TEST_P(test_ucp_tag_xfer, iov_unexp_sync) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_iov, false, true, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, contig_to_iov_exp_rndv_get, "RNDV_THRESH=1000",
+           "RNDV_SCHEME=get_zcopy") {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_contig_to_iov, true, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, contig_to_iov_unexp_rndv_get, "RNDV_THRESH=1000",
+           "RNDV_SCHEME=get_zcopy") {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_contig_to_iov, false, false, false);
+}
+
 /* send_contig_recv_contig */
 
 UCS_TEST_P(test_ucp_tag_xfer, send_contig_recv_contig_exp, "RNDV_THRESH=1248576") {
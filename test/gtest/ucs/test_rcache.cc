@@ -11,7 +11,9 @@ extern "C" {
 #include <ucs/stats/stats.h>
 #include <ucs/memory/rcache.h>
 #include <ucs/memory/rcache_int.h>
+#include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
+#include <ucs/time/time.h>
 #include <ucm/api/ucm.h>
 }
 #include <set>
@@ -32,7 +34,9 @@ UCS_TEST_F(test_rcache_basic, create_fail) {
         1000,
         &ops,
         NULL,
-        0
+        0,
+        UCS_ULUNITS_INF,
+        UCS_MEMUNITS_INF
     };
 
     ucs_rcache_t *rcache;
@@ -72,7 +76,9 @@ protected:
             1000,
             &ops,
             reinterpret_cast<void*>(this),
-            0
+            0,
+            max_regions(),
+            max_size()
         };
         UCS_TEST_CREATE_HANDLE_IF_SUPPORTED(ucs_rcache_t*, m_rcache, ucs_rcache_destroy,
                                             ucs_rcache_create, &params, "test", ucs_stats_get_root());
@@ -84,6 +90,14 @@ protected:
         ucs::test::cleanup();
     }
 
+    virtual unsigned long max_regions() const {
+        return UCS_ULUNITS_INF;
+    }
+
+    virtual size_t max_size() const {
+        return UCS_MEMUNITS_INF;
+    }
+
     region *get(void *address, size_t length, int prot = PROT_READ|PROT_WRITE) {
         ucs_status_t status;
         ucs_rcache_region_t *r;
@@ -542,6 +556,71 @@ UCS_MT_TEST_F(test_rcache, shared_region, 6) {
     shared_free(mem);
 }
 
+UCS_MT_TEST_F(test_rcache, get_hit_inv, 6) {
+    static const unsigned num_pages = 8;
+    const size_t page_size          = ucs_get_page_size();
+    const int count                 = 200 / ucs::test_time_multiplier();
+
+    /* first bytes hold the stop flag, followed by page-aligned buffer */
+    void *mem = shared_malloc((num_pages + 1) * page_size);
+    volatile int *stop = (volatile int*)mem;
+    void *buf = (void*)ucs_align_up((uintptr_t)mem + sizeof(*stop), page_size);
+    void *last_page = UCS_PTR_BYTE_OFFSET(buf, (num_pages - 1) * page_size);
+
+    if (barrier()) {
+        /* merge with the regions of the other threads, and invalidate the
+         * result by remapping the last page, while they look it up */
+        *stop = 0;
+        barrier();
+        for (int i = 0; i < count; ++i) {
+            put(get(buf, num_pages * page_size));
+
+            void *ptr = mmap(last_page, page_size, PROT_READ|PROT_WRITE,
+                             MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED, -1, 0);
+            EXPECT_EQ(last_page, ptr) << strerror(errno);
+
+            void *tmp = alloc_pages(page_size, PROT_READ|PROT_WRITE);
+            put(get(tmp, page_size));
+            munmap(tmp, page_size);
+        }
+        *stop = 1;
+    } else {
+        barrier();
+        while (!*stop) {
+            region *region = get(buf, page_size);
+            EXPECT_LE(region->super.super.start, (uintptr_t)buf);
+            EXPECT_GE(region->super.super.end, (uintptr_t)buf + page_size);
+            put(region);
+        }
+    }
+
+    barrier();
+    shared_free(mem);
+}
+
+UCS_MT_TEST_F(test_rcache, get_hit_perf, 8) {
+    static const size_t size = 1 * 1024 * 1024;
+    const size_t count       = 1000000ul / ucs::test_time_multiplier();
+
+    void *mem = shared_malloc(size);
+    put(get(mem, size));
+
+    barrier();
+    ucs_time_t start_time = ucs_get_time();
+    for (size_t i = 0; i < count; ++i) {
+        put(get(mem, size));
+    }
+    ucs_time_t end_time = ucs_get_time();
+
+    double lat = ucs_time_to_nsec(end_time - start_time) / count;
+    UCS_TEST_MESSAGE << lat << " nsec per get+put with " << num_threads()
+                     << " threads";
+
+    barrier();
+    EXPECT_EQ(1u, m_reg_count);
+    shared_free(mem);
+}
+
 class test_rcache_no_register : public test_rcache {
 protected:
     bool m_fail_reg;
@@ -640,6 +719,157 @@ UCS_MT_TEST_F(test_rcache_no_register, merge_invalid_prot_slow, 5)
     munmap(mem, size1+size2);
 }
 
+class test_rcache_lru : public test_rcache {
+protected:
+    enum {
+        MAX_REGIONS = 4,
+        MAX_PAGES   = 8,
+        NUM_PAGES   = 64
+    };
+
+    test_rcache_lru() : m_mem(NULL), m_reg_limit(UINT_MAX) {
+    }
+
+    virtual void init() {
+        test_rcache::init();
+        m_mem = alloc_pages(NUM_PAGES * ucs_get_page_size(),
+                            PROT_READ | PROT_WRITE);
+    }
+
+    virtual void cleanup() {
+        m_rcache.reset();
+        munmap(m_mem, NUM_PAGES * ucs_get_page_size());
+        test_rcache::cleanup();
+    }
+
+    virtual unsigned long max_regions() const {
+        return MAX_REGIONS;
+    }
+
+    virtual size_t max_size() const {
+        return MAX_PAGES * ucs_get_page_size();
+    }
+
+    virtual ucs_status_t mem_reg(region *region) {
+        /* simulate a device which runs out of registration resources */
+        if (m_reg_count >= m_reg_limit) {
+            return UCS_ERR_NO_RESOURCE;
+        }
+        return test_rcache::mem_reg(region);
+    }
+
+    /* pages are separated by a gap, so regions are never merged */
+    void *page(unsigned index, unsigned num_pages = 1) const {
+        ucs_assert((index + num_pages) <= NUM_PAGES);
+        return UCS_PTR_BYTE_OFFSET(m_mem, index * ucs_get_page_size());
+    }
+
+    region *get_pages(unsigned index, unsigned num_pages = 1) {
+        return get(page(index), num_pages * ucs_get_page_size() - 1);
+    }
+
+    void get_put_pages(unsigned index, unsigned num_pages = 1) {
+        put(get_pages(index, num_pages));
+    }
+
+    /* returns true if the page is cached: getting it does not register */
+    bool is_cached(unsigned index) {
+        uint32_t id = next_id;
+        get_put_pages(index);
+        return id == next_id;
+    }
+
+    void              *m_mem;
+    volatile uint32_t m_reg_limit;
+};
+
+UCS_TEST_F(test_rcache_lru, evict_by_count) {
+    for (unsigned i = 0; i < 8; ++i) {
+        get_put_pages(i * 2);
+        EXPECT_LE(m_reg_count, MAX_REGIONS);
+    }
+
+    EXPECT_EQ(MAX_REGIONS, m_reg_count);
+    EXPECT_EQ(MAX_REGIONS, m_rcache->lru.count);
+
+    /* the most recently used regions are kept */
+    for (unsigned i = 4; i < 8; ++i) {
+        EXPECT_TRUE(is_cached(i * 2)) << "page " << i * 2;
+    }
+    EXPECT_FALSE(is_cached(0));
+}
+
+UCS_TEST_F(test_rcache_lru, evict_by_size) {
+    get_put_pages(0, 3);
+    get_put_pages(4, 3);
+    EXPECT_EQ(2u, m_reg_count);
+
+    /* 9 pages would exceed the size limit */
+    get_put_pages(8, 3);
+    EXPECT_EQ(2u, m_reg_count);
+    EXPECT_LE(m_rcache->lru.size, max_size());
+    EXPECT_FALSE(is_cached(0));
+}
+
+UCS_TEST_F(test_rcache_lru, lru_order) {
+    for (unsigned i = 0; i < MAX_REGIONS; ++i) {
+        get_put_pages(i * 2);
+    }
+
+    /* page 0 becomes the most recently used, so page 2 is evicted first */
+    EXPECT_TRUE(is_cached(0));
+    get_put_pages(20);
+    EXPECT_TRUE(is_cached(0));
+    EXPECT_FALSE(is_cached(2));
+}
+
+UCS_TEST_F(test_rcache_lru, in_use_not_evicted) {
+    std::vector<region*> regions;
+
+    for (unsigned i = 0; i < MAX_REGIONS + 2; ++i) {
+        regions.push_back(get_pages(i * 2));
+    }
+
+    /* regions in use can not be evicted, so the limit is exceeded */
+    EXPECT_EQ(MAX_REGIONS + 2, m_reg_count);
+
+    for (unsigned i = 0; i < regions.size(); ++i) {
+        EXPECT_EQ(uint32_t(MAGIC), regions[i]->magic);
+        put(regions[i]);
+    }
+
+    /* once released, they are evicted on the next insertion */
+    get_put_pages(40);
+    EXPECT_EQ(MAX_REGIONS, m_reg_count);
+}
+
+UCS_TEST_F(test_rcache_lru, memory_pressure) {
+    get_put_pages(0);
+    get_put_pages(2);
+    EXPECT_EQ(2u, m_reg_count);
+
+    /* registration fails until the unused regions are evicted */
+    m_reg_limit = 2;
+    region *r   = get_pages(4);
+    EXPECT_EQ(1u, m_reg_count);
+    put(r);
+}
+
+UCS_MT_TEST_F(test_rcache_lru, stress, 6) {
+    for (unsigned i = 0; i < (10000 / ucs::test_time_multiplier()); ++i) {
+        unsigned index     = (ucs::rand() % (NUM_PAGES / 4)) * 4;
+        unsigned num_pages = 1 + (ucs::rand() % 3);
+        region *r          = get_pages(index, num_pages);
+
+        EXPECT_EQ(uint32_t(MAGIC), r->magic);
+        put(r);
+    }
+
+    barrier();
+    /* each thread may keep one region in use beyond the limit */
+    EXPECT_LE(m_reg_count, MAX_REGIONS + num_threads());
+}
+
 #ifdef ENABLE_STATS
 class test_rcache_stats : public test_rcache {
 protected:
@@ -682,6 +912,29 @@ protected:
     }
 };
 
+class test_rcache_stats_lru : public test_rcache_stats {
+protected:
+    virtual unsigned long max_regions() const {
+        return 1;
+    }
+};
+
+UCS_TEST_F(test_rcache_stats_lru, evict) {
+    static const size_t size = ucs_get_page_size();
+    void *mem = alloc_pages(3 * size, PROT_READ|PROT_WRITE);
+
+    put(get(mem, size));
+    EXPECT_EQ(0, get_counter(UCS_RCACHE_EVICTS));
+
+    put(get(UCS_PTR_BYTE_OFFSET(mem, 2 * size), size));
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_EVICTS));
+    EXPECT_EQ(2, get_counter(UCS_RCACHE_MISSES));
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_DEREGS));
+
+    m_rcache.reset();
+    munmap(mem, 3 * size);
+}
+
 UCS_TEST_F(test_rcache_stats, basic) {
     static const size_t size = 4096;
     void *ptr = malloc(size);
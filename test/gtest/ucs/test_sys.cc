@@ -93,6 +93,39 @@ UCS_TEST_F(test_sys, get_mem_prot) {
     UCS_TEST_MESSAGE << "Time: " << ucs_time_to_usec(duration) << " us";
 }
 
+UCS_TEST_F(test_sys, check_mem_readable) {
+    size_t page_size = ucs_get_page_size();
+    ucs_status_t status;
+    char *buffer;
+    int x = 0;
+
+    status = ucs_sys_check_mem_readable(&x, sizeof(x));
+    if (status == UCS_ERR_UNSUPPORTED) {
+        UCS_TEST_SKIP_R("memory check is not supported");
+    }
+    ASSERT_UCS_OK(status);
+
+    EXPECT_EQ(UCS_OK, ucs_sys_check_mem_readable(NULL, 0));
+    EXPECT_EQ(UCS_ERR_INVALID_ADDR, ucs_sys_check_mem_readable(NULL, 1));
+
+    buffer = (char*)mmap(NULL, 3 * page_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, buffer);
+
+    /* the last page is not readable */
+    ASSERT_EQ(0, mprotect(buffer + (2 * page_size), page_size, PROT_NONE));
+
+    EXPECT_EQ(UCS_OK, ucs_sys_check_mem_readable(buffer, 2 * page_size));
+    EXPECT_EQ(UCS_OK, ucs_sys_check_mem_readable(buffer + 1,
+                                                 (2 * page_size) - 1));
+    EXPECT_EQ(UCS_ERR_INVALID_ADDR,
+              ucs_sys_check_mem_readable(buffer, (2 * page_size) + 1));
+    EXPECT_EQ(UCS_ERR_INVALID_ADDR,
+              ucs_sys_check_mem_readable(buffer + (2 * page_size), 1));
+
+    munmap(buffer, 3 * page_size);
+}
+
 UCS_TEST_F(test_sys, fcntl) {
     ucs_status_t status;
     int fd, fl;
@@ -5,12 +5,16 @@
 
 #include <common/test.h>
 #include <uct/uct_test.h>
+#include <uct/test_p2p_rma.h>
 
 extern "C" {
 #include <uct/api/uct.h>
 #include <uct/tcp/tcp.h>
+#include <ucs/sys/sys.h>
 }
 
+#include <sys/mman.h>
+
 class test_uct_tcp : public uct_test {
 public:
     void init() {
@@ -255,3 +259,428 @@ UCS_TEST_P(test_uct_tcp, listener_flood_connect_and_close) {
 }
 
 _UCT_INSTANTIATE_TEST_CASE(test_uct_tcp, tcp)
+
+
+class test_uct_tcp_streams : public uct_p2p_rma_test {
+public:
+    void init() {
+        modify_config("NUM_STREAMS", ucs::to_string(NUM_STREAMS));
+        modify_config("STRIPE_MIN_SIZE", "1kb");
+        uct_p2p_rma_test::init();
+    }
+
+    uct_tcp_ep_t *sender_tcp_ep() {
+        return ucs_derived_of(sender_ep(), uct_tcp_ep_t);
+    }
+
+protected:
+    static const unsigned NUM_STREAMS = 4;
+};
+
+UCS_TEST_P(test_uct_tcp_streams, put_zcopy) {
+    if (!uct_tcp_ep_is_self(sender_tcp_ep())) {
+        EXPECT_EQ(NUM_STREAMS - 1, sender_tcp_ep()->streams.count);
+    }
+
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    0ul, 1024 * UCS_KBYTE, TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_P(test_uct_tcp_streams, put_zcopy_flush) {
+    mapped_buffer sendbuf(512 * UCS_KBYTE, SEED1, sender());
+    mapped_buffer recvbuf(512 * UCS_KBYTE, SEED2, receiver());
+
+    for (int i = 0; i < 10; ++i) {
+        sendbuf.pattern_fill(SEED1 + i);
+        blocking_send(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                      sender_ep(), sendbuf, recvbuf, true);
+        flush();
+        recvbuf.pattern_check(SEED1 + i);
+    }
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_streams, tcp)
+
+
+class test_uct_tcp_unix : public uct_p2p_rma_test {
+public:
+    uct_tcp_ep_t *sender_tcp_ep() {
+        return ucs_derived_of(sender_ep(), uct_tcp_ep_t);
+    }
+
+    void test_put_zcopy() {
+        test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                        0ul, 1024 * UCS_KBYTE, TEST_UCT_FLAG_SEND_ZCOPY);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_unix, put_zcopy) {
+    /* Peers of the test are on the same host */
+    EXPECT_TRUE(sender_tcp_ep()->flags & UCT_TCP_EP_FLAG_UNIX);
+    test_put_zcopy();
+}
+
+UCS_TEST_P(test_uct_tcp_unix, put_zcopy_no_unix, "UNIX_SOCKETS=n") {
+    EXPECT_FALSE(sender_tcp_ep()->flags & UCT_TCP_EP_FLAG_UNIX);
+    test_put_zcopy();
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_unix, tcp)
+
+
+class test_uct_tcp_busy_poll : public uct_p2p_rma_test {
+public:
+    void check_busy_poll(int expected_usec) {
+        uct_tcp_iface_t *iface = ucs_derived_of(sender().iface(),
+                                                uct_tcp_iface_t);
+
+        if (iface->sockopt.busy_poll == 0) {
+            UCS_TEST_SKIP_R("SO_BUSY_POLL is not permitted");
+        }
+
+        EXPECT_EQ(expected_usec, iface->sockopt.busy_poll);
+#if HAVE_DECL_SO_BUSY_POLL
+        uct_tcp_ep_t *ep = ucs_derived_of(sender_ep(), uct_tcp_ep_t);
+        int optval;
+
+        ASSERT_UCS_OK(ucs_socket_getopt(ep->fd, SOL_SOCKET, SO_BUSY_POLL,
+                                        &optval, sizeof(optval)));
+        EXPECT_EQ(expected_usec, optval);
+#endif
+
+        test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                        1ul, 64 * UCS_KBYTE, TEST_UCT_FLAG_SEND_ZCOPY);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_busy_poll, put_zcopy, "UNIX_SOCKETS=n",
+           "BUSY_POLL=50us") {
+    check_busy_poll(50);
+}
+
+UCS_TEST_P(test_uct_tcp_busy_poll, put_zcopy_prefer, "UNIX_SOCKETS=n",
+           "BUSY_POLL=50us", "PREFER_BUSY_POLL=y") {
+    check_busy_poll(50);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_busy_poll, tcp)
+
+
+class test_uct_tcp_msg_zcopy : public uct_p2p_rma_test {
+public:
+    static const uint8_t AM_ID = 1;
+
+    void init() {
+        /* MSG_ZEROCOPY isn't used on Unix domain sockets */
+        modify_config("UNIX_SOCKETS", "n");
+        uct_p2p_rma_test::init();
+
+        m_am_recvbuf = NULL;
+        m_am_count   = 0;
+    }
+
+    void check_msg_zcopy() {
+        uct_tcp_iface_t *iface = ucs_derived_of(sender().iface(),
+                                                uct_tcp_iface_t);
+
+        /* The iface disables MSG_ZEROCOPY if the kernel doesn't support it */
+        if (iface->config.zcopy.msg_zcopy_thresh == SIZE_MAX) {
+            UCS_TEST_SKIP_R("MSG_ZEROCOPY is not supported");
+        }
+    }
+
+    uint32_t msg_zcopy_sn() {
+        return ucs_derived_of(sender_ep(), uct_tcp_ep_t)->msg_zcopy.sn;
+    }
+
+    ucs_status_t am_zcopy(uct_ep_h ep, const mapped_buffer &sendbuf,
+                          const mapped_buffer &recvbuf) {
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), sendbuf.length(),
+                                sendbuf.memh(),
+                                sender().iface_attr().cap.am.max_iov);
+
+        m_am_recvbuf = &recvbuf;
+        return uct_ep_am_zcopy(ep, AM_ID, NULL, 0, iov, iovcnt, 0, comp());
+    }
+
+    static ucs_status_t am_handler(void *arg, void *data, size_t length,
+                                   unsigned flags) {
+        test_uct_tcp_msg_zcopy *self = reinterpret_cast<test_uct_tcp_msg_zcopy*>
+                                           (arg);
+
+        EXPECT_EQ(self->m_am_recvbuf->length(), length);
+        memcpy(self->m_am_recvbuf->ptr(), data,
+               ucs_min(length, self->m_am_recvbuf->length()));
+        ++self->m_am_count;
+        return UCS_OK;
+    }
+
+protected:
+    const mapped_buffer *m_am_recvbuf;
+    volatile unsigned   m_am_count;
+};
+
+UCS_TEST_P(test_uct_tcp_msg_zcopy, am_zcopy, "MSG_ZCOPY_THRESH=0") {
+    check_msg_zcopy();
+
+    EXPECT_EQ(ucs_get_page_size(),
+              sender().iface_attr().cap.am.opt_zcopy_align);
+
+    ucs_status_t status = uct_iface_set_am_handler(receiver().iface(), AM_ID,
+                                                   am_handler, this, 0);
+    ASSERT_UCS_OK(status);
+
+    size_t max_length = sender().iface_attr().cap.am.max_zcopy;
+    for (size_t length = 1; length <= max_length; length *= 4) {
+        mapped_buffer sendbuf(length, SEED1 + length, sender());
+        mapped_buffer recvbuf(length, 0, receiver());
+
+        m_am_count = 0;
+        /* The completion is invoked only after the kernel notifies that the
+         * send buffer is not used anymore */
+        blocking_send(static_cast<send_func_t>(&test_uct_tcp_msg_zcopy::am_zcopy),
+                      sender_ep(), sendbuf, recvbuf, true);
+        wait_for_value(&m_am_count, 1u, true);
+        recvbuf.pattern_check(SEED1 + length);
+    }
+
+    EXPECT_GT(msg_zcopy_sn(), 0u);
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+}
+
+UCS_TEST_P(test_uct_tcp_msg_zcopy, put_zcopy, "MSG_ZCOPY_THRESH=0") {
+    check_msg_zcopy();
+
+    EXPECT_EQ(ucs_get_page_size(),
+              sender().iface_attr().cap.put.opt_zcopy_align);
+
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    1ul, 1024 * UCS_KBYTE, TEST_UCT_FLAG_SEND_ZCOPY);
+    EXPECT_GT(msg_zcopy_sn(), 0u);
+}
+
+UCS_TEST_P(test_uct_tcp_msg_zcopy, put_zcopy_thresh, "MSG_ZCOPY_THRESH=64k") {
+    check_msg_zcopy();
+
+    /* Alignment isn't changed for operations sent without MSG_ZEROCOPY */
+    EXPECT_EQ(1ul, sender().iface_attr().cap.put.opt_zcopy_align);
+
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    1ul, 1024 * UCS_KBYTE, TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_msg_zcopy, tcp)
+
+
+class test_uct_tcp_get : public uct_p2p_rma_test {
+public:
+    struct get_completion {
+        uct_completion_t uct;
+        ucs_status_t     status;
+        volatile bool    done;
+    };
+
+    static void get_completion_cb(uct_completion_t *self, ucs_status_t status) {
+        get_completion *comp = ucs_container_of(self, get_completion, uct);
+
+        comp->status = status;
+        comp->done   = true;
+    }
+
+    static void get_completion_init(get_completion *comp) {
+        comp->uct.func  = get_completion_cb;
+        comp->uct.count = 1;
+        comp->status    = UCS_ERR_LAST;
+        comp->done      = false;
+    }
+
+    uct_tcp_ep_t *sender_tcp_ep() {
+        return ucs_derived_of(sender_ep(), uct_tcp_ep_t);
+    }
+
+    void get_zcopy_nb(const mapped_buffer &buffer, uint64_t remote_addr,
+                      get_completion *comp) {
+        ucs_status_t status;
+
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, buffer.ptr(), buffer.length(),
+                                buffer.memh(), 1);
+
+        get_completion_init(comp);
+        do {
+            status = uct_ep_get_zcopy(sender_ep(), iov, iovcnt, remote_addr,
+                                      0, &comp->uct);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_get, get_zcopy_disable, "GET_ENABLE=n") {
+    EXPECT_FALSE(sender().iface_attr().cap.flags & UCT_IFACE_FLAG_GET_ZCOPY);
+    EXPECT_EQ(0ul, sender().iface_attr().cap.get.max_zcopy);
+}
+
+UCS_TEST_P(test_uct_tcp_get, get_zcopy_partial_rx) {
+    uct_tcp_iface_t *iface = ucs_derived_of(sender().iface(), uct_tcp_iface_t);
+    size_t length          = 16 * iface->config.rx_seg_size;
+    bool get_rx            = false;
+    get_completion comp;
+
+    mapped_buffer sendbuf(length, 0, sender());
+    mapped_buffer recvbuf(length, SEED1, receiver());
+
+    /* The response doesn't fit the RX buffer, so the rest of it is received
+     * directly to the user's buffer */
+    get_zcopy_nb(sendbuf, recvbuf.addr(), &comp);
+
+    ucs_time_t deadline = ucs_get_time() + ucs_time_from_sec(DEFAULT_TIMEOUT_SEC);
+    while (!comp.done && (ucs_get_time() < deadline)) {
+        progress();
+        get_rx = get_rx || (sender_tcp_ep()->flags & UCT_TCP_EP_FLAG_GET_RX);
+    }
+
+    ASSERT_TRUE(comp.done);
+    EXPECT_UCS_OK(comp.status);
+    EXPECT_TRUE(get_rx);
+    sendbuf.pattern_check(SEED1);
+}
+
+UCS_TEST_P(test_uct_tcp_get, get_zcopy_invalid_addr) {
+    size_t page_size = ucs_get_page_size();
+    get_completion comp;
+
+    if (ucs_sys_check_mem_readable(&comp, sizeof(comp)) == UCS_ERR_UNSUPPORTED) {
+        UCS_TEST_SKIP_R("memory check is not supported");
+    }
+
+    void *remote = mmap(NULL, page_size, PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, remote);
+
+    mapped_buffer sendbuf(page_size, 0, sender());
+    mapped_buffer recvbuf(page_size, SEED1, receiver());
+
+    /* Only the failed operation is completed with an error, the connection
+     * is still usable */
+    get_zcopy_nb(sendbuf, (uintptr_t)remote, &comp);
+    wait_for_value(&comp.done, true, true);
+    ASSERT_TRUE(comp.done);
+    EXPECT_EQ(UCS_ERR_INVALID_ADDR, comp.status);
+
+    get_zcopy_nb(sendbuf, recvbuf.addr(), &comp);
+    wait_for_value(&comp.done, true, true);
+    ASSERT_TRUE(comp.done);
+    EXPECT_UCS_OK(comp.status);
+    sendbuf.pattern_check(SEED1);
+
+    munmap(remote, page_size);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_get, tcp)
+
+
+class test_uct_tcp_get_peer_failure : public uct_test {
+public:
+    test_uct_tcp_get_peer_failure() :
+        m_sender(NULL), m_receiver(NULL), m_err_count(0) {
+    }
+
+    void init() {
+        uct_iface_params_t params;
+
+        uct_test::init();
+
+        params.field_mask        = UCT_IFACE_PARAM_FIELD_ERR_HANDLER       |
+                                   UCT_IFACE_PARAM_FIELD_ERR_HANDLER_ARG   |
+                                   UCT_IFACE_PARAM_FIELD_ERR_HANDLER_FLAGS |
+                                   UCT_IFACE_PARAM_FIELD_OPEN_MODE;
+        params.err_handler       = err_cb;
+        params.err_handler_arg   = reinterpret_cast<void*>(this);
+        params.err_handler_flags = 0;
+        params.open_mode         = UCT_IFACE_OPEN_MODE_DEVICE;
+
+        m_sender = uct_test::create_entity(params);
+        m_entities.push_back(m_sender);
+
+        m_receiver = uct_test::create_entity(params);
+        m_entities.push_back(m_receiver);
+
+        m_sender->connect(0, *m_receiver, 0);
+    }
+
+    static ucs_status_t err_cb(void *arg, uct_ep_h ep, ucs_status_t status) {
+        reinterpret_cast<test_uct_tcp_get_peer_failure*>(arg)->m_err_count++;
+        return UCS_OK;
+    }
+
+    void get_zcopy(const mapped_buffer &buffer, uint64_t remote_addr,
+                   test_uct_tcp_get::get_completion *comp) {
+        ucs_status_t status;
+
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, buffer.ptr(), buffer.length(),
+                                buffer.memh(), 1);
+
+        test_uct_tcp_get::get_completion_init(comp);
+        do {
+            status = uct_ep_get_zcopy(m_sender->ep(0), iov, iovcnt,
+                                      remote_addr, 0, &comp->uct);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+protected:
+    entity            *m_sender;
+    entity            *m_receiver;
+    volatile unsigned m_err_count;
+};
+
+UCS_TEST_P(test_uct_tcp_get_peer_failure, get_zcopy) {
+    static const unsigned NUM_GETS = 4;
+    test_uct_tcp_get::get_completion comps[NUM_GETS];
+    size_t length = UCS_MBYTE;
+
+    /* The remote buffer must outlive the receiver entity, TCP doesn't
+     * register memory, so it's allocated by the sender */
+    mapped_buffer sendbuf(length, 0, *m_sender);
+    mapped_buffer recvbuf(length, 0, *m_sender);
+
+    /* Establish the connection */
+    get_zcopy(sendbuf, recvbuf.addr(), &comps[0]);
+    wait_for_value(&comps[0].done, true, true);
+    ASSERT_TRUE(comps[0].done);
+    ASSERT_UCS_OK(comps[0].status);
+
+    /* The receiver doesn't progress the requests before it is destroyed */
+    for (unsigned i = 0; i < NUM_GETS; ++i) {
+        get_zcopy(sendbuf, recvbuf.addr(), &comps[i]);
+    }
+
+    {
+        scoped_log_handler slh(wrap_errors_logger);
+
+        m_entities.remove(m_receiver);
+        m_receiver = NULL;
+
+        for (unsigned i = 0; i < NUM_GETS; ++i) {
+            wait_for_value(&comps[i].done, true, true);
+        }
+    }
+
+    for (unsigned i = 0; i < NUM_GETS; ++i) {
+        ASSERT_TRUE(comps[i].done) << "GET " << i;
+        EXPECT_NE(UCS_OK, comps[i].status) << "GET " << i;
+    }
+
+    EXPECT_GT(m_err_count, 0u);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_get_peer_failure, tcp)
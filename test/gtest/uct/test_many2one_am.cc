@@ -98,6 +98,13 @@ public:
         }
     }
 
+    static ucs_status_t count_handler(void *arg, void *data, size_t length,
+                                      unsigned flags) {
+        test_many2one_am *self = reinterpret_cast<test_many2one_am*>(arg);
+        ucs_atomic_add32(&self->m_am_count, 1);
+        return UCS_OK;
+    }
+
     static const size_t NUM_SENDERS = 10;
 
 protected:
@@ -170,4 +177,67 @@ UCS_TEST_SKIP_COND_P(test_many2one_am, am_bcopy,
     buffers.clear();
 }
 
+UCS_TEST_SKIP_COND_P(test_many2one_am, am_short_rate,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    const unsigned num_sends = 50000 / ucs::test_time_multiplier();
+    const size_t sizes[]     = { 8, 16, 32, 64 };
+    uint64_t payload[8]      = { 0 };
+    ucs_status_t status;
+
+    for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+        entity *sender = create_entity(0);
+        sender->connect(0, *m_receiver, i);
+        m_entities.push_back(sender);
+    }
+
+    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                      count_handler, (void*)this, 0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned s = 0; s < ucs_static_array_size(sizes); ++s) {
+        const size_t length = sizes[s];
+        if (length > ent(1).iface_attr().cap.am.max_short) {
+            continue;
+        }
+
+        m_am_count = 0;
+
+        ucs_time_t start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_sends; ++i) {
+            const entity& sender = ent((i % NUM_SENDERS) + 1);
+            for (;;) {
+                status = uct_ep_am_short(sender.ep(0), AM_ID, payload[0],
+                                         &payload[1],
+                                         length - sizeof(payload[0]));
+                if (status != UCS_ERR_NO_RESOURCE) {
+                    break;
+                }
+                m_receiver->progress();
+                sender.progress();
+            }
+            ASSERT_UCS_OK(status);
+        }
+
+        while (m_am_count < num_sends) {
+            progress();
+        }
+        ucs_time_t duration = ucs_get_time() - start_time;
+
+        UCS_TEST_MESSAGE << NUM_SENDERS << " senders, " << length
+                         << " bytes: " << std::fixed << std::setprecision(2)
+                         << (num_sends / ucs_time_to_sec(duration) / 1e6)
+                         << " Mpps";
+    }
+
+    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, NULL, NULL,
+                                      0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+        ent(i + 1).flush();
+    }
+}
+
 UCT_INSTANTIATE_NO_SELF_TEST_CASE(test_many2one_am)
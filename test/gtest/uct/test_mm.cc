@@ -7,6 +7,8 @@
 extern "C" {
 #include <uct/api/uct.h>
 #include <uct/sm/mm/base/mm_md.h>
+#include <uct/sm/mm/base/mm_ep.h>
+#include <ucs/memory/numa.h>
 #include <ucs/time/time.h>
 }
 #include "uct_p2p_test.h"
@@ -186,6 +188,57 @@ public:
         test_rkey(ptr, memh, size);
     }
 
+    static ucs_status_t seq_am_handler(void *arg, void *data, size_t length,
+                                       unsigned flags) {
+        std::vector<uint32_t> *seqs = (std::vector<uint32_t>*)arg;
+        uint64_t hdr                = *(uint64_t*)data;
+        uint32_t sender             = hdr >> 32;
+
+        EXPECT_EQ((*seqs)[sender], (uint32_t)hdr) << "sender " << sender;
+        (*seqs)[sender] = (uint32_t)hdr + 1;
+        return UCS_OK;
+    }
+
+    static size_t pack_seq(void *dest, void *arg) {
+        *(uint64_t*)dest = *(uint64_t*)arg;
+        return sizeof(uint64_t);
+    }
+
+    static bool ep_has_ring(uct_ep_h ep) {
+        return ucs_derived_of(ep, uct_mm_ep_t)->ring.ctl != NULL;
+    }
+
+    void send_seq(const entity &sender, uint64_t hdr, bool bcopy) {
+        ssize_t status;
+
+        do {
+            if (bcopy) {
+                status = uct_ep_am_bcopy(sender.ep(0), 0, pack_seq, &hdr, 0);
+            } else {
+                status = uct_ep_am_short(sender.ep(0), 0, hdr, NULL, 0);
+            }
+            progress();
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_GE(status, 0);
+    }
+
+    void send_seqs(const std::vector<entity*> &senders,
+                   std::vector<uint32_t> &seqs, unsigned count) {
+        std::vector<uint32_t> expected(seqs);
+
+        for (unsigned i = 0; i < count; ++i) {
+            for (unsigned s = 0; s < senders.size(); ++s) {
+                send_seq(*senders[s], ((uint64_t)s << 32) | expected[s],
+                         (i % 3) == 0);
+                ++expected[s];
+            }
+        }
+
+        while (seqs != expected) {
+            progress();
+        }
+    }
+
 protected:
     entity *m_e1, *m_e2;
 };
@@ -217,6 +270,74 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, open_for_posix,
     free(recv_buffer);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, sender_rings,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_AM_BCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "SENDER_RINGS=2", "SENDER_RING_SIZE=4")
+{
+    const unsigned count = 1000 / ucs::test_time_multiplier();
+    std::vector<entity*> senders;
+    std::vector<uint32_t> seqs(3, 0);
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, seq_am_handler, &seqs, 0);
+
+    /* two senders take the rings, the third one uses the shared FIFO */
+    senders.push_back(m_e1);
+    for (unsigned i = 0; i < 2; ++i) {
+        senders.push_back(uct_test::create_entity(0));
+        m_entities.push_back(senders.back());
+        senders.back()->connect(0, *m_e2, 0);
+    }
+
+    EXPECT_TRUE(ep_has_ring(senders[0]->ep(0)));
+    EXPECT_TRUE(ep_has_ring(senders[1]->ep(0)));
+    EXPECT_FALSE(ep_has_ring(senders[2]->ep(0)));
+
+    send_seqs(senders, seqs, count);
+
+    /* a released ring is recycled by the receiver and taken by a new ep */
+    senders[0]->destroy_ep(0);
+    short_progress_loop();
+    senders[2]->destroy_ep(0);
+    senders[2]->connect(0, *m_e2, 0);
+    EXPECT_TRUE(ep_has_ring(senders[2]->ep(0)));
+
+    senders.erase(senders.begin());
+    seqs.erase(seqs.begin());
+    send_seqs(senders, seqs, count);
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, NULL, NULL, 0);
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, numa_bind,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_AM_BCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "NUMA_POLICY=bind")
+{
+    const unsigned count = 1000 / ucs::test_time_multiplier();
+    std::vector<entity*> senders(1, m_e1);
+    std::vector<uint32_t> seqs(1, 0);
+
+    /* the receive resources are placed on the node of the creating thread,
+     * or not bound at all if NUMA information is not available */
+    if (ucs_numa_current_node() < 0) {
+        EXPECT_EQ(-1, m_e2->iface_attr().numa_node);
+    } else {
+        EXPECT_GE(m_e2->iface_attr().numa_node, 0);
+    }
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, seq_am_handler, &seqs, 0);
+    send_seqs(senders, seqs, count);
+    uct_iface_set_am_handler(m_e2->iface(), 0, NULL, NULL, 0);
+}
+
+UCS_TEST_P(test_uct_mm, numa_default, "NUMA_POLICY=default")
+{
+    EXPECT_EQ(-1, m_e2->iface_attr().numa_node);
+}
+
 UCS_TEST_SKIP_COND_P(test_uct_mm, alloc,
                      !check_md_caps(UCT_MD_FLAG_ALLOC)) {
 
@@ -236,6 +357,55 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, alloc,
     ASSERT_UCS_OK(status);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, rkey_cache,
+                     (GetParam()->md_name != "posix") ||
+                     !check_md_caps(UCT_MD_FLAG_ALLOC)) {
+
+    const size_t size = 100000;
+    uct_rkey_bundle_t rkey_ob[3];
+    void *rkey_ptr[3];
+    ucs_status_t status;
+
+    for (int i = 0; i < 2; ++i) {
+        void   *address     = NULL;
+        size_t alloc_length = size;
+        uct_mem_h memh;
+        status = uct_md_mem_alloc(m_e1->md(), &alloc_length, &address,
+                                  UCT_MD_MEM_ACCESS_ALL, "test_mm", &memh);
+        ASSERT_UCS_OK(status);
+
+        std::vector<uint8_t> rkey_buffer(m_e1->md_attr().rkey_packed_size);
+        status = uct_md_mkey_pack(m_e1->md(), memh, &rkey_buffer[0]);
+        ASSERT_UCS_OK(status);
+
+        /* a second rkey, and a rkey unpacked after all others were released,
+         * reuse the mapping of the first one */
+        for (int j = 0; j < 3; ++j) {
+            status = uct_rkey_unpack(GetParam()->component, &rkey_buffer[0],
+                                     &rkey_ob[j]);
+            ASSERT_UCS_OK(status);
+            status = uct_rkey_ptr(GetParam()->component, &rkey_ob[j],
+                                  (uintptr_t)address, &rkey_ptr[j]);
+            ASSERT_UCS_OK(status);
+            if (j == 1) {
+                uct_rkey_release(GetParam()->component, &rkey_ob[0]);
+                uct_rkey_release(GetParam()->component, &rkey_ob[1]);
+            }
+        }
+
+        EXPECT_EQ(rkey_ptr[0], rkey_ptr[1]);
+        EXPECT_EQ(rkey_ptr[0], rkey_ptr[2]);
+
+        /* the memory allocated in the second iteration may get the same segment
+         * id, and must not be served from the stale cached mapping */
+        test_attach_ptr(address, rkey_ptr[2], 0xdeadbeef33333 + i);
+
+        uct_rkey_release(GetParam()->component, &rkey_ob[2]);
+        status = uct_md_mem_free(m_e1->md(), memh);
+        ASSERT_UCS_OK(status);
+    }
+}
+
 UCS_TEST_SKIP_COND_P(test_uct_mm, reg,
                      !check_md_caps(UCT_MD_FLAG_REG)) {
 
@@ -160,3 +160,36 @@ UCS_TEST_SKIP_COND_P(test_p2p_rma_madvise, madvise,
 }
 
 UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_madvise)
+
+class test_p2p_rma_tx_threads : public uct_p2p_rma_test {
+protected:
+    void test_xfer_sizes(send_func_t send, unsigned flags) {
+        static const size_t sizes[] = { 1000, 64 * UCS_KBYTE,
+                                        UCS_MBYTE + 1234, 4 * UCS_MBYTE };
+
+        for (size_t i = 0; i < ucs_static_array_size(sizes); ++i) {
+            test_xfer(send, sizes[i], flags, UCS_MEMORY_TYPE_HOST);
+        }
+    }
+};
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_tx_threads, put_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY),
+                     "SCOPY_TX_THREADS=2", "SCOPY_TX_THREADS_THRESH=64k",
+                     "SCOPY_SEG_SIZE=16k")
+{
+    test_xfer_sizes(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_tx_threads, get_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY),
+                     "SCOPY_TX_THREADS=2", "SCOPY_TX_THREADS_THRESH=64k",
+                     "SCOPY_SEG_SIZE=16k")
+{
+    test_xfer_sizes(static_cast<send_func_t>(&uct_p2p_rma_test::get_zcopy),
+                    TEST_UCT_FLAG_RECV_ZCOPY);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_tx_threads, cma)
+_UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_tx_threads, knem)